@@ -0,0 +1,49 @@
+#include <random>
+
+#include "accessPath.h"
+#include "workload.h"
+
+int main() {
+    long long rows = 100000;
+    mt19937_64 rng(7);
+    KeyGenerator gen(KeyDistribution::Uniform, rows);
+    Table table = generateTable(gen, rows, 16, 4, rng);
+
+    cout << "==== Building indexes over " << rows << " rows ====" << endl;
+    FullScan scan(table);
+
+    int capacity = BlockGeometry::keysPerBlock;
+    HashIndexAccess hash(rows / (capacity * 3 / 4), capacity);
+    BPlusTreeAccess btree(BlockGeometry::blockBytes, BlockGeometry::keyBytes, BlockGeometry::pointerBytes);
+    for (long long rowId = 0; rowId < rows; rowId++) {
+        hash.insert(rowId, table.row(rowId));
+        btree.insert(rowId, table.row(rowId));
+    }
+
+    BitmapIndexAccess bitmap(rows, BlockGeometry::bitsPerBlock, table.blockCount(), table.rowsPerBlock, {"a", "b"});
+    bitmap.build(table);
+
+    AccessPathSelector selector(buildCatalog(table), DiskProfile::HDD());
+    selector.addPath(&scan);
+    selector.addPath(&hash);
+    selector.addPath(&btree);
+    selector.addPath(&bitmap);
+
+    int probe = table.keys[rows / 2];
+    vector<Predicate> queries = {
+        Predicate::equal("key", probe),
+        Predicate::between("key", probe, probe + 2000),
+        Predicate::between("key", 0, (int)(rows * 2)),
+        Predicate::equal("a", 3),
+        Predicate::both(Predicate::equal("a", 3), Predicate::equal("b", 1)),
+        Predicate::either(Predicate::equal("a", 3), Predicate::equal("b", 1)),
+    };
+
+    cout << "Disk profile: " << selector.diskProfile().name << " (* = chosen path)" << endl;
+    for (const Predicate& q : queries) {
+        cout << "\n==== " << q.describe() << " ====" << endl;
+        selector.printReports(selector.explain(q));
+    }
+
+    return 0;
+}
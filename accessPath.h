@@ -0,0 +1,142 @@
+#ifndef ACCESS_PATH_H
+#define ACCESS_PATH_H
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <string>
+
+#include "diskModel.h"
+#include "index.h"
+
+using namespace std;
+
+// Cost-based choice between a full scan and the index structures. Every
+// registered path estimates the predicate from the column statistics; the
+// cheapest one under the disk profile runs, and its prediction is reported
+// next to the I/O it actually caused.
+
+struct PathEstimate {
+    string path;
+    CostEstimate cost;
+};
+
+struct AccessPathReport {
+    string predicate;
+    string path;
+    bool chosen = false;
+    CostEstimate estimated;
+    IOStats measured;
+    vector<int> rows;
+
+    static string csvHeader() {
+        return "predicate,path,chosen,est_seeks,est_transfers,est_ms,seeks,transfers,ms,rows";
+    }
+
+    string toCSV(const DiskProfile& profile) const {
+        ostringstream out;
+        out << "\"" << predicate << "\"," << path << "," << (chosen ? 1 : 0) << ","
+            << estimated.seeks << "," << estimated.transfers << "," << estimated.ms(profile) << ","
+            << measured.seeks() << "," << measured.transfers() << "," << measured.estimateMs(profile) << ","
+            << rows.size();
+        return out.str();
+    }
+};
+
+class AccessPathSelector {
+private:
+    vector<Index*> paths;     // not owned
+    StatsCatalog stats;
+    DiskProfile profile;
+
+    AccessPathReport run(Index* path, const Predicate& predicate, const CostEstimate& estimate) {
+        AccessPathReport report;
+        report.predicate = predicate.describe();
+        report.path = path->name();
+        report.estimated = estimate;
+
+        DiskModel::park();
+        IOScope query;
+        report.rows = path->evaluate(predicate);
+        report.measured = query.stats();
+        return report;
+    }
+
+public:
+    AccessPathSelector(const StatsCatalog& catalog, const DiskProfile& disk = DiskProfile::SSD())
+        : stats(catalog), profile(disk) {}
+
+    void addPath(Index* path) {
+        paths.push_back(path);
+    }
+
+    void updateStats(const StatsCatalog& catalog) {
+        stats = catalog;
+    }
+
+    const DiskProfile& diskProfile() const {
+        return profile;
+    }
+
+    vector<PathEstimate> estimateAll(const Predicate& predicate) {
+        vector<PathEstimate> estimates;
+        for (Index* path : paths) {
+            estimates.push_back({path->name(), path->estimate(predicate, stats)});
+        }
+        return estimates;
+    }
+
+    // Cheapest supported path, or nullptr if no path can answer the predicate
+    Index* choose(const Predicate& predicate, CostEstimate* cost = nullptr) {
+        Index* best = nullptr;
+        CostEstimate bestCost = CostEstimate::unsupported();
+        for (Index* path : paths) {
+            CostEstimate c = path->estimate(predicate, stats);
+            if (c.supported && (!best || c.ms(profile) < bestCost.ms(profile))) {
+                best = path;
+                bestCost = c;
+            }
+        }
+        if (cost) *cost = bestCost;
+        return best;
+    }
+
+    // Run the predicate through the chosen path
+    AccessPathReport execute(const Predicate& predicate) {
+        CostEstimate cost;
+        Index* path = choose(predicate, &cost);
+        if (!path) throw invalid_argument("no access path supports " + predicate.describe());
+        AccessPathReport report = run(path, predicate, cost);
+        report.chosen = true;
+        return report;
+    }
+
+    // Run the predicate through every supported path, to check the estimates
+    vector<AccessPathReport> explain(const Predicate& predicate) {
+        Index* chosen = choose(predicate);
+        vector<AccessPathReport> reports;
+        for (Index* path : paths) {
+            CostEstimate c = path->estimate(predicate, stats);
+            if (!c.supported) continue;
+            reports.push_back(run(path, predicate, c));
+            reports.back().chosen = path == chosen;
+        }
+        return reports;
+    }
+
+    void printReports(const vector<AccessPathReport>& reports) {
+        cout << fixed << setprecision(2);
+        for (const AccessPathReport& r : reports) {
+            cout << (r.chosen ? " * " : "   ") << setw(10) << left << r.path << right
+                 << " est " << setw(8) << r.estimated.seeks << " seeks " << setw(9) << r.estimated.transfers
+                 << " transfers " << setw(9) << r.estimated.ms(profile) << " ms"
+                 << " | measured " << setw(6) << r.measured.seeks() << " seeks " << setw(7) << r.measured.transfers()
+                 << " transfers " << setw(9) << r.measured.estimateMs(profile) << " ms"
+                 << " | " << r.rows.size() << " rows" << endl;
+        }
+        cout.unsetf(ios::floatfield);
+    }
+};
+
+#endif
@@ -0,0 +1,346 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <algorithm>
+
+#include "diskModel.h"
+#include "workload.h"
+#include "hashIndex.h"
+#include "btreeIndex.h"
+#include "bitmapIndex.h"
+
+using namespace std;
+
+// Builds HashIndex, BPlusTree and BitmapIndex over the same generated table
+// and runs seeded workload mixes against them, one CSV row per
+// (rows, distribution, workload, index).
+
+struct BenchConfig {
+    vector<long long> rows = {1000, 10000, 100000};
+    vector<KeyDistribution> distributions = {KeyDistribution::Uniform, KeyDistribution::Zipfian,
+                                             KeyDistribution::Sequential, KeyDistribution::Clustered};
+    vector<string> workloads = {"point", "range", "boolean", "insert"};
+    vector<string> indexes = {"hash", "btree", "bitmap"};
+    long long ops = 10000;
+    long long booleanOps = 20;         // bitmap predicates touch every row, so run fewer
+    double rangeSelectivity = 0.001;   // fraction of the key domain covered by a range query
+    double insertRatio = 0.9;          // inserts vs lookups in the insert-heavy mix
+    unsigned long long seed = 42;
+    double zipfTheta = DEFAULT_ZIPF_THETA;             // see workload.h for why not 0.99
+    double keyDomainFactor = DEFAULT_KEY_DOMAIN_FACTOR;
+    int blockBytes = BlockGeometry::blockBytes;
+    int keyBytes = BlockGeometry::keyBytes;
+    int pointerBytes = BlockGeometry::pointerBytes;
+    int cardinalityA = 16;
+    int cardinalityB = 4;
+    DiskProfile profile = DiskProfile::SSD();
+};
+
+struct Measurement {
+    long long ops = 0;
+    double seconds = 0;
+    vector<double> latenciesUs;
+    IOStats io;
+
+    void add(const Measurement& other) {
+        ops += other.ops;
+        seconds += other.seconds;
+        latenciesUs.insert(latenciesUs.end(), other.latenciesUs.begin(), other.latenciesUs.end());
+        io.add(other.io);
+    }
+};
+
+// Time `ops` calls of op(i) one by one, collecting simulated I/O per call
+template <typename Op>
+Measurement measure(long long ops, Op op) {
+    using Clock = chrono::steady_clock;
+    Measurement m;
+    m.ops = ops;
+    m.latenciesUs.reserve(ops);
+    DiskModel::reset();
+
+    Clock::time_point begin = Clock::now();
+    for (long long i = 0; i < ops; i++) {
+        IOScope query;
+        Clock::time_point t0 = Clock::now();
+        op(i);
+        m.latenciesUs.push_back(chrono::duration<double, micro>(Clock::now() - t0).count());
+    }
+    m.seconds = chrono::duration<double>(Clock::now() - begin).count();
+    m.io = DiskModel::stats();
+    return m;
+}
+
+double percentile(vector<double> values, double p) {
+    if (values.empty()) return 0;
+    size_t k = min(values.size() - 1, (size_t)(p * values.size()));
+    nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+
+string csvHeader() {
+    return "rows,distribution,workload,index,ops,seconds,throughput_ops_s,p50_us,p99_us,memory_bytes,"
+           "seeks,transfers,read_transfers,write_transfers,seeks_per_op,transfers_per_op,"
+           "profile,est_ms_per_op,seed,zipf_theta,key_domain_factor";
+}
+
+void report(ostream& out, const BenchConfig& cfg, long long rows, KeyDistribution dist, const string& workload,
+            const string& index, const Measurement& m, size_t memoryBytes) {
+    double ops = max(1LL, m.ops);
+    out << rows << "," << distributionName(dist) << "," << workload << "," << index << ","
+        << m.ops << "," << m.seconds << "," << (m.seconds > 0 ? m.ops / m.seconds : 0) << ","
+        << percentile(m.latenciesUs, 0.50) << "," << percentile(m.latenciesUs, 0.99) << ","
+        << memoryBytes << ","
+        << m.io.seeks() << "," << m.io.transfers() << ","
+        << m.io.readTransfers << "," << m.io.writeTransfers << ","
+        << m.io.seeks() / ops << "," << m.io.transfers() / ops << ","
+        << cfg.profile.name << "," << m.io.estimateMs(cfg.profile) / ops << ","
+        << cfg.seed << "," << cfg.zipfTheta << "," << cfg.keyDomainFactor << endl;
+}
+
+bool wants(const vector<string>& list, const string& name) {
+    return find(list.begin(), list.end(), name) != list.end();
+}
+
+// Query inputs are generated up front so the timed loops only touch the index
+struct QuerySet {
+    vector<int> pointKeys;
+    vector<int> rangeLows;
+    vector<bool> isInsert;
+    vector<int> insertKeys;
+    int rangeWidth = 1;
+};
+
+QuerySet makeQueries(const BenchConfig& cfg, KeyDistribution dist, const Table& table,
+                     KeyGenerator& gen, mt19937_64& rng) {
+    QuerySet q;
+    long long n = table.keys.size();
+    q.rangeWidth = max(1, (int)(cfg.rangeSelectivity * gen.keyDomain()));
+
+    // Uniform and Zipfian lookups follow the data distribution (hits and
+    // misses); sequential and clustered streams never repeat a key, so their
+    // lookups probe keys of existing rows instead.
+    bool probeExisting = dist == KeyDistribution::Sequential || dist == KeyDistribution::Clustered;
+    for (long long i = 0; i < cfg.ops; i++) {
+        int key = probeExisting ? table.keys[rng() % n] : gen.next(rng);
+        q.pointKeys.push_back(key);
+        q.rangeLows.push_back(key);
+        q.isInsert.push_back(uniform_real_distribution<double>(0.0, 1.0)(rng) < cfg.insertRatio);
+    }
+    // New keys for the insert mix continue the same stream
+    for (long long i = 0; i < cfg.ops; i++) q.insertKeys.push_back(gen.next(rng));
+    return q;
+}
+
+void runHash(ostream& out, const BenchConfig& cfg, long long rows, KeyDistribution dist,
+             const Table& table, const QuerySet& q) {
+    int capacity = cfg.blockBytes / cfg.keyBytes;
+    int numBuckets = max(1LL, (long long)(rows / (capacity * 0.75)));
+    HashIndex index(numBuckets, capacity);
+
+    Measurement build = measure(rows, [&](long long i) { index.insert(table.keys[i]); });
+    report(out, cfg, rows, dist, "build", "hash", build, index.memoryBytes());
+
+    if (wants(cfg.workloads, "point")) {
+        Measurement m = measure(cfg.ops, [&](long long i) { index.search(q.pointKeys[i]); });
+        report(out, cfg, rows, dist, "point", "hash", m, index.memoryBytes());
+    }
+    if (wants(cfg.workloads, "insert")) {
+        Measurement m = measure(cfg.ops, [&](long long i) {
+            if (q.isInsert[i]) index.insert(q.insertKeys[i]);
+            else index.search(q.pointKeys[i]);
+        });
+        report(out, cfg, rows, dist, "insert", "hash", m, index.memoryBytes());
+    }
+}
+
+void runBTree(ostream& out, const BenchConfig& cfg, long long rows, KeyDistribution dist,
+              const Table& table, const QuerySet& q) {
+    BPlusTree index(cfg.blockBytes, cfg.keyBytes, cfg.pointerBytes);
+
+    Measurement build = measure(rows, [&](long long i) { index.insert(table.keys[i], (int)i); });
+    report(out, cfg, rows, dist, "build", "btree", build, index.memoryBytes());
+
+    if (wants(cfg.workloads, "point")) {
+        Measurement m = measure(cfg.ops, [&](long long i) {
+            int value;
+            index.search(q.pointKeys[i], value);
+        });
+        report(out, cfg, rows, dist, "point", "btree", m, index.memoryBytes());
+    }
+    if (wants(cfg.workloads, "range")) {
+        vector<int> result;
+        Measurement m = measure(cfg.ops, [&](long long i) {
+            result.clear();
+            index.searchRange(q.rangeLows[i], q.rangeLows[i] + q.rangeWidth, result);
+        });
+        report(out, cfg, rows, dist, "range", "btree", m, index.memoryBytes());
+    }
+    if (wants(cfg.workloads, "insert")) {
+        Measurement m = measure(cfg.ops, [&](long long i) {
+            int value;
+            if (q.isInsert[i]) index.insert(q.insertKeys[i], (int)(rows + i));
+            else index.search(q.pointKeys[i], value);
+        });
+        report(out, cfg, rows, dist, "insert", "btree", m, index.memoryBytes());
+    }
+}
+
+void runBitmap(ostream& out, const BenchConfig& cfg, long long rows, KeyDistribution dist,
+               const Table& table, mt19937_64& rng) {
+    int bitsPerBlock = cfg.blockBytes * 8;
+    int rowsPerBlock = max(1, cfg.blockBytes / (3 * cfg.keyBytes));
+    int dataBlockCount = (rows + rowsPerBlock - 1) / rowsPerBlock;
+    BitmapIndex index(rows, bitsPerBlock, dataBlockCount, rowsPerBlock);
+    index.setVerbose(false);
+
+    // One scan of the table sets the bits of every bitmap, then each is flushed once
+    vector<string> namesA, namesB;
+    for (int v = 0; v < cfg.cardinalityA; v++) namesA.push_back("a=" + to_string(v));
+    for (int v = 0; v < cfg.cardinalityB; v++) namesB.push_back("b=" + to_string(v));
+    for (const string& name : namesA) index.createBitmap(name);
+    for (const string& name : namesB) index.createBitmap(name);
+
+    Measurement build = measure(1, [&](long long) { loadDataBlocks(rows, rowsPerBlock); });
+    build.add(measure(rows, [&](long long i) {
+        index.setBitBuffered(namesA[table.columnA[i]], (int)i, true);
+        index.setBitBuffered(namesB[table.columnB[i]], (int)i, true);
+    }));
+    build.add(measure(1, [&](long long) {
+        for (const string& name : namesA) index.flushBitmapToDisk(name);
+        for (const string& name : namesB) index.flushBitmapToDisk(name);
+    }));
+    build.ops = rows;
+    report(out, cfg, rows, dist, "build", "bitmap", build, index.memoryBytes());
+
+    if (wants(cfg.workloads, "boolean")) {
+        vector<int> valuesA, valuesB;
+        for (long long i = 0; i < cfg.booleanOps; i++) {
+            valuesA.push_back(rng() % cfg.cardinalityA);
+            valuesB.push_back(rng() % cfg.cardinalityB);
+        }
+        // Alternate AND and OR predicates over the two columns
+        Measurement m = measure(cfg.booleanOps, [&](long long i) {
+            if (i % 2 == 0) index.bitmapAND(namesA[valuesA[i]], namesB[valuesB[i]]);
+            else index.bitmapOR(namesA[valuesA[i]], namesB[valuesB[i]]);
+        });
+        report(out, cfg, rows, dist, "boolean", "bitmap", m, index.memoryBytes());
+    }
+}
+
+vector<string> splitList(const string& text) {
+    vector<string> items;
+    stringstream ss(text);
+    string item;
+    while (getline(ss, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+void printUsage() {
+    cerr << "Usage: benchmark [options]\n"
+         << "  --rows N[,N...]          table sizes (default 1000,10000,100000)\n"
+         << "  --dist D[,D...]          uniform, zipfian, sequential, clustered\n"
+         << "  --workload W[,W...]      point, range, boolean, insert\n"
+         << "  --index I[,I...]         hash, btree, bitmap\n"
+         << "  --ops N                  operations per workload (default 10000)\n"
+         << "  --boolean-ops N          bitmap predicates per run (default 20)\n"
+         << "  --range-selectivity F    range width as a fraction of the key domain\n"
+         << "  --insert-ratio F         share of inserts in the insert mix (default 0.9)\n"
+         << "  --seed N                 random seed (default 42)\n"
+         << "  --zipf-theta F           Zipfian skew in (0, 1) (default 0.5)\n"
+         << "  --key-domain F           key domain as a multiple of the row count (default 4)\n"
+         << "  --profile P              hdd, ssd or nvme for latency estimates\n"
+         << "  --out FILE               write CSV to FILE instead of stdout\n";
+}
+
+int main(int argc, char* argv[]) {
+    BenchConfig cfg;
+    string outputPath;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            string arg = argv[i];
+            if (arg == "--help" || arg == "-h") {
+                printUsage();
+                return 0;
+            }
+            if (i + 1 >= argc) throw invalid_argument("missing value for " + arg);
+            string value = argv[++i];
+
+            if (arg == "--rows") {
+                cfg.rows.clear();
+                for (const string& r : splitList(value)) cfg.rows.push_back(stoll(r));
+            } else if (arg == "--dist") {
+                cfg.distributions.clear();
+                for (const string& d : splitList(value)) cfg.distributions.push_back(parseDistribution(d));
+            } else if (arg == "--workload") {
+                cfg.workloads = splitList(value);
+            } else if (arg == "--index") {
+                cfg.indexes = splitList(value);
+            } else if (arg == "--ops") {
+                cfg.ops = stoll(value);
+            } else if (arg == "--boolean-ops") {
+                cfg.booleanOps = stoll(value);
+            } else if (arg == "--range-selectivity") {
+                cfg.rangeSelectivity = stod(value);
+            } else if (arg == "--insert-ratio") {
+                cfg.insertRatio = stod(value);
+            } else if (arg == "--seed") {
+                cfg.seed = stoull(value);
+            } else if (arg == "--zipf-theta") {
+                cfg.zipfTheta = stod(value);
+                if (!(cfg.zipfTheta > 0 && cfg.zipfTheta < 1)) throw invalid_argument("--zipf-theta must be in (0, 1)");
+            } else if (arg == "--key-domain") {
+                cfg.keyDomainFactor = stod(value);
+                if (cfg.keyDomainFactor < 1) throw invalid_argument("--key-domain must be at least 1");
+            } else if (arg == "--profile") {
+                if (value == "hdd") cfg.profile = DiskProfile::HDD();
+                else if (value == "ssd") cfg.profile = DiskProfile::SSD();
+                else if (value == "nvme") cfg.profile = DiskProfile::NVMe();
+                else throw invalid_argument("unknown profile: " + value);
+            } else if (arg == "--out") {
+                outputPath = value;
+            } else {
+                throw invalid_argument("unknown option: " + arg);
+            }
+        }
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        printUsage();
+        return 1;
+    }
+
+    ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath);
+        if (!file) {
+            cerr << "Error: cannot write " << outputPath << endl;
+            return 1;
+        }
+    }
+    ostream& out = outputPath.empty() ? cout : file;
+    out << csvHeader() << endl;
+
+    for (long long rows : cfg.rows) {
+        for (KeyDistribution dist : cfg.distributions) {
+            // Every (rows, distribution) pair gets its own reproducible streams
+            mt19937_64 dataRng(cfg.seed * 1000003 + rows * 31 + (int)dist);
+            mt19937_64 queryRng(dataRng() ^ cfg.seed);
+
+            KeyGenerator gen(dist, rows, cfg.zipfTheta, cfg.keyDomainFactor);
+            Table table = generateTable(gen, rows, cfg.cardinalityA, cfg.cardinalityB, dataRng);
+            QuerySet queries = makeQueries(cfg, dist, table, gen, queryRng);
+
+            if (wants(cfg.indexes, "hash")) runHash(out, cfg, rows, dist, table, queries);
+            if (wants(cfg.indexes, "btree")) runBTree(out, cfg, rows, dist, table, queries);
+            if (wants(cfg.indexes, "bitmap")) runBitmap(out, cfg, rows, dist, table, queryRng);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,311 @@
+#ifndef BITMAP_INDEX_H
+#define BITMAP_INDEX_H
+
+#include <iostream>
+#include <vector>
+#include <unordered_map>
+#include <string>
+
+#include "diskModel.h"
+
+using namespace std;
+
+// Simulate scanning all data blocks (once at the start)
+inline void loadDataBlocks(int totalRows, int rowsPerBlock, int dataBlockStart = 0) {
+    int totalBlocks = (totalRows + rowsPerBlock - 1) / rowsPerBlock;
+    for (int i = 0; i < totalBlocks; i++) {
+        diskAccess(dataBlockStart + i); // Ensure unique block number for data
+    }
+}
+
+
+
+class BitmapIndex {
+private:
+    int numRows;             // Total records in table
+    int bitsPerBlock;        // How many bits fit in one disk block
+    int blocksPerBitmap;     // How many blocks needed per bitmap
+    int dataBlockCount;      // Number of data blocks in the table
+    int rowsPerDataBlock;    // How many table rows fit in one data block
+    bool verbose = true;     // Announce each query on stdout
+    
+    // Maps column values to their bitmap blocks
+    // Each bitmap is stored as vector of blocks, each block contains multiple bits
+    unordered_map<string, vector<vector<bool>>> bitmaps;
+    
+    // Calculate which block contains a given row
+    int getBlockForRow(int rowId) {
+        return rowId / bitsPerBlock;
+    }
+    
+    // Calculate which table block holds a given row
+    int getDataBlockForRow(int rowId) {
+        return rowId / rowsPerDataBlock;
+    }
+
+    // Calculate position within a block for a given row
+    int getPositionInBlock(int rowId) {
+        return rowId % bitsPerBlock;
+    }
+    
+    // Generate unique block number for each bitmap's blocks
+    int getBitmapBlockId(const string& bitmap, int blockIdx) {
+        size_t h = hash<string>{}(bitmap);
+        return dataBlockCount + ((h % 1000) * blocksPerBitmap + blockIdx); // Shift to avoid overlap
+    }
+    
+public:
+    BitmapIndex(int rows, int blockSize, int dataBlocks, int rowsPerBlock)
+    : numRows(rows), bitsPerBlock(blockSize), dataBlockCount(dataBlocks), rowsPerDataBlock(rowsPerBlock) {
+        blocksPerBitmap = (numRows + bitsPerBlock - 1) / bitsPerBlock;
+    }
+    
+    // Create a bitmap for a column value
+    void createBitmap(const string& columnValue) {
+        if (bitmaps.find(columnValue) != bitmaps.end()) {
+            cout << "Bitmap for " << columnValue << " already exists" << endl;
+            return;
+        }
+        
+        // Initialize bitmap with all blocks set to false
+        vector<vector<bool>> bitmap(blocksPerBitmap, vector<bool>(bitsPerBlock, false));
+        bitmaps[columnValue] = bitmap;
+    }
+    
+    // Set bits in memory only, to be flushed later
+    void setBitBuffered(const string& columnValue, int rowId, bool value) {
+        if (bitmaps.find(columnValue) == bitmaps.end()) {
+            createBitmap(columnValue);
+        }
+
+        int blockIdx = getBlockForRow(rowId);
+        int position = getPositionInBlock(rowId);
+        bitmaps[columnValue][blockIdx][position] = value;
+    }
+
+    // Set one bit and write back only the block that holds it
+    void setBit(const string& columnValue, int rowId, bool value) {
+        setBitBuffered(columnValue, rowId, value);
+        diskAccess(getBitmapBlockId(columnValue, getBlockForRow(rowId)), AccessType::Write);
+    }
+
+    // After all bits are set, flush to disk once per bitmap
+    void flushBitmapToDisk(const string& columnValue) {
+        for (int blockIdx = 0; blockIdx < blocksPerBitmap; blockIdx++) {
+            int physicalBlockId = getBitmapBlockId(columnValue, blockIdx);
+            diskAccess(physicalBlockId, AccessType::Write); // Simulate writing this bitmap block
+        }
+    }
+    
+
+
+    
+    // Execute equality check (query a column for specific value)
+    vector<bool> equalityQuery(const string& columnValue) {
+        if (bitmaps.find(columnValue) == bitmaps.end()) {
+            cerr << "Error: Bitmap for " << columnValue << " not found" << endl;
+            return vector<bool>();
+        }
+    
+        if (verbose) cout << "Executing equality query: " << columnValue << endl;
+        vector<bool> result(numRows, false);
+    
+        for (int blockIdx = 0; blockIdx < blocksPerBitmap; blockIdx++) {
+            int physicalBlockId = getBitmapBlockId(columnValue, blockIdx);
+            diskAccess(physicalBlockId); // Simulate reading bitmap block
+    
+            for (int pos = 0; pos < bitsPerBlock; pos++) {
+                int rowId = blockIdx * bitsPerBlock + pos;
+                if (rowId < numRows) {
+                    result[rowId] = bitmaps[columnValue][blockIdx][pos];
+                }
+            }
+        }
+    
+        // Simulate accessing only those data blocks whose bits are 1
+        unordered_map<int, bool> accessedBlocks;
+        for (int rowId = 0; rowId < numRows; rowId++) {
+            if (result[rowId]) {
+                int dataBlock = getDataBlockForRow(rowId);
+                if (!accessedBlocks[dataBlock]) {
+                    diskAccess(dataBlock); // Read original table block
+                    accessedBlocks[dataBlock] = true;
+                }
+            }
+        }
+    
+        return result;
+    }
+    
+    
+    // Perform AND operation between two bitmaps
+    vector<bool> bitmapAND(const string& columnValue1, const string& columnValue2) {
+        if (bitmaps.find(columnValue1) == bitmaps.end() || 
+            bitmaps.find(columnValue2) == bitmaps.end()) {
+            cerr << "Error: One or both bitmaps not found" << endl;
+            return vector<bool>();
+        }
+    
+        if (verbose) cout << "Executing AND operation: " << columnValue1 << " AND " << columnValue2 << endl;
+        vector<bool> result(numRows, false);
+        int physicalBlockId1 = getBitmapBlockId(columnValue1, 0);
+        int physicalBlockId2 = getBitmapBlockId(columnValue2, 0);
+        for (int i = 0; i < blocksPerBitmap; i++) {
+            diskAccess(physicalBlockId1);
+        }
+        for (int i = 0; i < blocksPerBitmap; i++) {
+            diskAccess(physicalBlockId2);
+        }
+
+        for (int blockIdx = 0; blockIdx < blocksPerBitmap; blockIdx++) {
+            int physicalBlockId1 = getBitmapBlockId(columnValue1, blockIdx);
+            int physicalBlockId2 = getBitmapBlockId(columnValue2, blockIdx);
+            for (int pos = 0; pos < bitsPerBlock; pos++) {
+                int rowId = blockIdx * bitsPerBlock + pos;
+                if (rowId < numRows) {
+                    result[rowId] = bitmaps[columnValue1][blockIdx][pos] && 
+                                    bitmaps[columnValue2][blockIdx][pos];
+                }
+            }
+        }
+        // Simulate reading only data blocks where result bit is 1
+        for (int rowId = 0; rowId < numRows; rowId++) {
+            if (result[rowId]) {
+                int dataBlock = getDataBlockForRow(rowId);
+                diskAccess(dataBlock);
+            }
+        }
+    
+        return result;
+    }
+    
+    
+    // Perform OR operation between two bitmaps
+    vector<bool> bitmapOR(const string& columnValue1, const string& columnValue2) {
+        if (bitmaps.find(columnValue1) == bitmaps.end() || 
+            bitmaps.find(columnValue2) == bitmaps.end()) {
+            cerr << "Error: One or both bitmaps not found" << endl;
+            return vector<bool>();
+        }
+    
+        if (verbose) cout << "Executing OR operation: " << columnValue1 << " OR " << columnValue2 << endl;
+        vector<bool> result(numRows, false);
+    
+        int physicalBlockId1 = getBitmapBlockId(columnValue1, 0);
+        int physicalBlockId2 = getBitmapBlockId(columnValue2, 0);
+        for (int i = 0; i < blocksPerBitmap; i++) {
+            diskAccess(physicalBlockId1);
+        }
+        for (int i = 0; i < blocksPerBitmap; i++) {
+            diskAccess(physicalBlockId2);
+        }
+
+        for (int blockIdx = 0; blockIdx < blocksPerBitmap; blockIdx++) {
+            int physicalBlockId1 = getBitmapBlockId(columnValue1, blockIdx);
+            int physicalBlockId2 = getBitmapBlockId(columnValue2, blockIdx);
+            for (int pos = 0; pos < bitsPerBlock; pos++) {
+                int rowId = blockIdx * bitsPerBlock + pos;
+                if (rowId < numRows) {
+                    result[rowId] = bitmaps[columnValue1][blockIdx][pos] || 
+                                    bitmaps[columnValue2][blockIdx][pos];
+                }
+            }
+        }
+        // Simulate reading only data blocks where result bit is 1
+        for (int rowId = 0; rowId < numRows; rowId++) {
+            if (result[rowId]) {
+                int dataBlock = getDataBlockForRow(rowId);
+                diskAccess(dataBlock);
+            }
+        }
+    
+        return result;
+    }
+    
+    
+    bool hasBitmap(const string& columnValue) const {
+        return bitmaps.find(columnValue) != bitmaps.end();
+    }
+
+    int getNumRows() const {
+        return numRows;
+    }
+
+    int getBitsPerBlock() const {
+        return bitsPerBlock;
+    }
+
+    int getRowsPerDataBlock() const {
+        return rowsPerDataBlock;
+    }
+
+    int getBlocksPerBitmap() const {
+        return blocksPerBitmap;
+    }
+
+    void setVerbose(bool on) {
+        verbose = on;
+    }
+
+    // Approximate in-memory footprint of all bitmaps
+    size_t memoryBytes() const {
+        size_t bytes = sizeof(*this);
+        for (auto& entry : bitmaps) {
+            bytes += entry.first.capacity() + sizeof(entry);
+            bytes += entry.second.capacity() * sizeof(vector<bool>);
+            bytes += entry.second.size() * ((bitsPerBlock + 7) / 8);
+        }
+        return bytes;
+    }
+
+    // OR any number of bitmaps, reading each one once, then read the data
+    // blocks holding a match. Values without a bitmap match no rows.
+    vector<bool> bitmapUnion(const vector<string>& columnValues) {
+        if (verbose) cout << "Executing union of " << columnValues.size() << " bitmaps" << endl;
+        vector<bool> result(numRows, false);
+
+        for (const string& columnValue : columnValues) {
+            auto bitmap = bitmaps.find(columnValue);
+            if (bitmap == bitmaps.end()) continue;
+            for (int blockIdx = 0; blockIdx < blocksPerBitmap; blockIdx++) {
+                diskAccess(getBitmapBlockId(columnValue, blockIdx));
+                const vector<bool>& block = bitmap->second[blockIdx];
+                for (int pos = 0; pos < bitsPerBlock; pos++) {
+                    int rowId = blockIdx * bitsPerBlock + pos;
+                    if (rowId < numRows && block[pos]) result[rowId] = true;
+                }
+            }
+        }
+
+        int lastDataBlock = -1;
+        for (int rowId = 0; rowId < numRows; rowId++) {
+            if (result[rowId] && getDataBlockForRow(rowId) != lastDataBlock) {
+                lastDataBlock = getDataBlockForRow(rowId);
+                diskAccess(lastDataBlock);
+            }
+        }
+        return result;
+    }
+
+    // Get matching rows from a result bitmap
+    vector<int> getMatchingRows(const vector<bool>& bitmap) {
+        vector<int> rows;
+        for (int i = 0; i < bitmap.size(); i++) {
+            if (bitmap[i]) {
+                rows.push_back(i);
+            }
+        }
+        return rows;
+    }
+    
+    // Print a bitmap in readable format
+    void printBitmap(const vector<bool>& bitmap) {
+        cout << "Bitmap: ";
+        for (bool bit : bitmap) {
+            cout << (bit ? "1" : "0");
+        }
+        cout << endl;
+    }
+};
+
+#endif
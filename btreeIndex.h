@@ -0,0 +1,390 @@
+#ifndef BTREE_INDEX_H
+#define BTREE_INDEX_H
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <queue>
+#include <algorithm>
+#include <climits>
+#include <atomic>
+
+#include "diskModel.h"
+
+using namespace std;
+
+// Shared by every tree; atomic so trees can be built on different threads
+inline atomic<int> globalBlockID(0);
+
+// Node structure
+struct BPlusNode {
+    bool isLeaf;
+    vector<int> keys;
+    vector<BPlusNode*> children;                // for internal nodes
+    vector<pair<int, int>> keyValuePairs;       // for leaf nodes
+    BPlusNode* next;                            // for leaf chaining
+    int blockID;
+
+    BPlusNode(bool leaf) : isLeaf(leaf), next(nullptr) {
+        blockID = globalBlockID++;
+    }
+};
+
+class BPlusTree {
+private:
+    BPlusNode* root;
+    int order;
+    int leafCount = 1;          // leaves in the chain, kept up to date by splitChild
+    int contiguousLeaves = 0;   // leaves whose successor is the very next block
+
+    static bool adjacent(BPlusNode* leaf, BPlusNode* next) {
+        return next && next->blockID == leaf->blockID + 1;
+    }
+
+    // Split a full child of `parent`. The child is read and written back,
+    // the new sibling is written, and so is the parent that now links to it.
+    void splitChild(BPlusNode* parent, int index, BPlusNode* child) {
+        BPlusNode* newChild = new BPlusNode(child->isLeaf);
+        diskAccess(child->blockID);
+
+        int mid = order;
+
+        if (child->isLeaf) {
+            newChild->keyValuePairs.assign(child->keyValuePairs.begin() + mid, child->keyValuePairs.end());
+            child->keyValuePairs.resize(mid);
+            child->keys.resize(mid);
+
+            contiguousLeaves -= adjacent(child, child->next);
+            newChild->next = child->next;
+            child->next = newChild;
+            contiguousLeaves += adjacent(child, newChild) + adjacent(newChild, newChild->next);
+            leafCount++;
+
+            newChild->keys.clear();
+            for (auto& kv : newChild->keyValuePairs)
+                newChild->keys.push_back(kv.first);
+
+            parent->keys.insert(parent->keys.begin() + index, newChild->keyValuePairs[0].first);
+        } else {
+            newChild->keys.assign(child->keys.begin() + mid + 1, child->keys.end());
+            newChild->children.assign(child->children.begin() + mid + 1, child->children.end());
+
+            int promotedKey = child->keys[mid];
+
+            child->keys.resize(mid);
+            child->children.resize(mid + 1);
+
+            parent->keys.insert(parent->keys.begin() + index, promotedKey);
+        }
+
+        parent->children.insert(parent->children.begin() + index + 1, newChild);
+
+        diskAccess(child->blockID, AccessType::Write);
+        diskAccess(newChild->blockID, AccessType::Write);
+        diskAccess(parent->blockID, AccessType::Write);
+    }
+
+    void freeNode(BPlusNode* node) {
+        for (BPlusNode* child : node->children) freeNode(child);
+        delete node;
+    }
+
+    size_t nodeBytes(BPlusNode* node) {
+        size_t bytes = sizeof(BPlusNode)
+                     + node->keys.capacity() * sizeof(int)
+                     + node->children.capacity() * sizeof(BPlusNode*)
+                     + node->keyValuePairs.capacity() * sizeof(pair<int, int>);
+        for (BPlusNode* child : node->children) bytes += nodeBytes(child);
+        return bytes;
+    }
+
+    // Descend to the leaf for key. `loaded` is set when a split just
+    // wrote the node, so it is still in memory and not read again.
+    void insertNonFull(BPlusNode* node, int key, int value, bool loaded = false) {
+        if (!loaded) diskAccess(node->blockID);
+
+        if (node->isLeaf) {
+            auto pos = lower_bound(node->keyValuePairs.begin(), node->keyValuePairs.end(), make_pair(key, value));
+            node->keyValuePairs.insert(pos, {key, value});
+
+            node->keys.clear();
+            for (auto& kv : node->keyValuePairs)
+                node->keys.push_back(kv.first);
+            diskAccess(node->blockID, AccessType::Write);
+        } else {
+            int i = upper_bound(node->keys.begin(), node->keys.end(), key) - node->keys.begin();
+            BPlusNode* child = node->children[i];
+            bool split = child->keys.size() == order*2;
+            if (split) {
+                splitChild(node, i, child);
+                if (key > node->keys[i]) i++;
+            }
+            insertNonFull(node->children[i], key, value, split);
+        }
+    }
+
+    // Inner nodes of the last descent with the largest key each one covers;
+    // a child picked by lower_bound holds keys up to the separator right of it
+    struct DescentPath {
+        vector<BPlusNode*> nodes;
+        vector<long long> highKeys;
+    };
+
+    // Like findLeaf, for keys in ascending order: only the inner nodes below
+    // the lowest one on `path` that still covers `key` are read again
+    BPlusNode* findLeafFrom(DescentPath& path, int key) {
+        while (!path.nodes.empty() && path.highKeys.back() < key) {
+            path.nodes.pop_back();
+            path.highKeys.pop_back();
+        }
+        if (path.nodes.empty()) {
+            if (root->isLeaf) return root;
+            diskAccess(root->blockID);
+            path.nodes.push_back(root);
+            path.highKeys.push_back(LLONG_MAX);
+        }
+
+        while (true) {
+            BPlusNode* curr = path.nodes.back();
+            int i = lower_bound(curr->keys.begin(), curr->keys.end(), key) - curr->keys.begin();
+            BPlusNode* child = curr->children[i];
+            if (child->isLeaf) return child;
+            diskAccess(child->blockID);
+            long long high = i < (int)curr->keys.size() ? curr->keys[i] : path.highKeys.back();
+            path.nodes.push_back(child);
+            path.highKeys.push_back(high);
+        }
+    }
+
+public:
+    BPlusTree(int C, int gamma, int eta) {
+        root = new BPlusNode(true);
+        order = (C - eta) / (2 * (gamma + eta));
+    }
+
+    ~BPlusTree() {
+        freeNode(root);
+    }
+
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+
+    int getOrder() {
+        return order;
+    }
+
+    void insert(int key, int value) {
+        if (root->keys.size() == order*2) {
+            BPlusNode* newRoot = new BPlusNode(false);
+            newRoot->children.push_back(root);
+            splitChild(newRoot, 0, root);
+            root = newRoot;
+            insertNonFull(root, key, value, true);
+            return;
+        }
+        insertNonFull(root, key, value);
+    }
+
+    bool search(int key, int& valueOut) {
+        BPlusNode* curr = root;
+        while (!curr->isLeaf) {
+            diskAccess(curr->blockID);
+            int i = upper_bound(curr->keys.begin(), curr->keys.end(), key) - curr->keys.begin();
+            curr = curr->children[i];
+        }
+
+        diskAccess(curr->blockID);
+        for (auto& kv : curr->keyValuePairs) {
+            if (kv.first == key) {
+                valueOut = kv.second;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void searchLessThan(int value, vector<int>& result) {
+        BPlusNode* curr = root;
+    
+        // Go to the leftmost leaf (first block)
+        while (!curr->isLeaf) {
+            diskAccess(curr->blockID);
+            curr = curr->children[0];
+        }
+    
+        // Traverse until value is passed
+        while (curr != nullptr) {
+            diskAccess(curr->blockID);
+            for (auto& kv : curr->keyValuePairs) {
+                if (kv.first < value) {
+                    result.push_back(kv.second);
+                } else {
+                    return; // Early exit once we cross the threshold
+                }
+            }
+            curr = curr->next;
+        }
+    }
+    
+
+    void searchGreaterThan(int value, vector<int>& result) {
+        BPlusNode* curr = root;
+
+        // Traverse to the appropriate leaf node where the value might exist
+        while (!curr->isLeaf) {
+            diskAccess(curr->blockID);
+            int i = upper_bound(curr->keys.begin(), curr->keys.end(), value) - curr->keys.begin();
+            curr = curr->children[i];
+        }
+
+        // Traverse the leaf nodes starting from the found node
+        while (curr != nullptr) {
+            diskAccess(curr->blockID);
+            for (auto& kv : curr->keyValuePairs) {
+                if (kv.first > value) {
+                    result.push_back(kv.second);
+                }
+            }
+            curr = curr->next;
+        }
+    }
+    
+
+    // Values of all keys in [low, high], walking the leaf chain from low
+    void searchRange(int low, int high, vector<int>& result) {
+        BPlusNode* curr = root;
+        while (!curr->isLeaf) {
+            diskAccess(curr->blockID);
+            int i = lower_bound(curr->keys.begin(), curr->keys.end(), low) - curr->keys.begin();
+            curr = curr->children[i];
+        }
+
+        while (curr != nullptr) {
+            diskAccess(curr->blockID);
+            for (auto& kv : curr->keyValuePairs) {
+                if (kv.first > high) return;
+                if (kv.first >= low) result.push_back(kv.second);
+            }
+            curr = curr->next;
+        }
+    }
+
+    // Leaf whose entries may start at `key`; reads the inner nodes on the
+    // way down but leaves reading the leaf itself to the caller
+    BPlusNode* findLeaf(int key) {
+        BPlusNode* curr = root;
+        while (!curr->isLeaf) {
+            diskAccess(curr->blockID);
+            int i = lower_bound(curr->keys.begin(), curr->keys.end(), key) - curr->keys.begin();
+            curr = curr->children[i];
+        }
+        return curr;
+    }
+
+    // Probe keys given in ascending order. A key just past the current leaf
+    // (judged by the key spread of that leaf) is looked for in the next leaf;
+    // otherwise the tree is descended again, re-reading only the inner nodes
+    // that the previous descent does not share. Matches are (position, value).
+    void searchBatch(const vector<int>& sortedKeys, vector<pair<int, int>>& matches) {
+        if (root->isLeaf && root->keyValuePairs.empty()) return;
+
+        DescentPath path;
+        BPlusNode* leaf = nullptr;
+        size_t runBegin = 0, runEnd = 0;    // matches of the previous key
+        for (size_t i = 0; i < sortedKeys.size(); i++) {
+            int key = sortedKeys[i];
+
+            // The cursor may already be past a repeated key's entries
+            if (i > 0 && key == sortedKeys[i - 1]) {
+                for (size_t m = runBegin; m < runEnd; m++) matches.push_back({(int)i, matches[m].second});
+                runBegin = runEnd;
+                runEnd = matches.size();
+                continue;
+            }
+
+            if (!leaf || key > leaf->keyValuePairs.back().first) {
+                bool nearby = leaf && leaf->next
+                    && (long long)key - leaf->keyValuePairs.back().first
+                       <= (long long)leaf->keyValuePairs.back().first - leaf->keyValuePairs.front().first;
+                if (nearby) {
+                    leaf = leaf->next;
+                    diskAccess(leaf->blockID);
+                }
+                if (!nearby || key > leaf->keyValuePairs.back().first) {
+                    leaf = findLeafFrom(path, key);
+                    diskAccess(leaf->blockID);
+                }
+            }
+
+            // Duplicates of a key may continue into the following leaves
+            runBegin = matches.size();
+            while (true) {
+                auto it = lower_bound(leaf->keyValuePairs.begin(), leaf->keyValuePairs.end(),
+                                      make_pair(key, INT_MIN));
+                for (; it != leaf->keyValuePairs.end() && it->first == key; ++it) {
+                    matches.push_back({(int)i, it->second});
+                }
+                if (it != leaf->keyValuePairs.end() || leaf->next == nullptr) break;
+                leaf = leaf->next;
+                diskAccess(leaf->blockID);
+            }
+            runEnd = matches.size();
+        }
+    }
+
+    // Approximate in-memory footprint of every node
+    size_t memoryBytes() {
+        return sizeof(*this) + nodeBytes(root);
+    }
+
+    void printTree() {
+        queue<BPlusNode*> q;
+        q.push(root);
+        cout << "\nTree Structure:\n";
+
+        while (!q.empty()) {
+            int levelSize = q.size();
+            while (levelSize--) {
+                BPlusNode* node = q.front(); q.pop();
+                if (node->isLeaf) {
+                    cout << "[";
+                    for (auto& kv : node->keyValuePairs) cout << kv.first << ":" << kv.second << " ";
+                    cout << "]";
+                } else {
+                    cout << "<";
+                    for (int k : node->keys) cout << k << " ";
+                    cout << ">";
+                    for (auto child : node->children) q.push(child);
+                }
+                cout << "  ";
+            }
+            cout << endl;
+        }
+    }
+
+    int calculateHeight() {
+        int height = 0;
+        BPlusNode* curr = root;
+        while (curr && !curr->isLeaf) {
+            height++;
+            curr = curr->children[0];
+        }
+        return height + 1; // include leaf level
+    }
+
+    // Leaves in the chain and how many of them are followed by the very next
+    // block on disk (structure only, no disk access)
+    pair<int, int> leafChainStats() const {
+        return {leafCount, contiguousLeaves};
+    }
+
+    void resetDiskMetrics() {
+        DiskModel::reset();
+    }
+
+    pair<int, int> getDiskMetrics() {
+        return {(int)DiskModel::stats().seeks(), (int)DiskModel::stats().transfers()};
+    }
+};
+
+#endif
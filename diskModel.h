@@ -0,0 +1,188 @@
+#ifndef DISK_MODEL_H
+#define DISK_MODEL_H
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <map>
+
+using namespace std;
+
+// Shared I/O cost model for all indexes. Every index reports block accesses
+// through diskAccess(); the model counts a seek whenever the block is not the
+// current block or the one right after it. The head starts "parked" (no
+// current block), so the first access of a run is always a seek.
+
+enum class AccessType { Read, Write };
+
+// Per-device timings used to turn seeks/transfers into latency estimates
+struct DiskProfile {
+    string name;
+    double seekMs;      // average positioning time
+    double transferMs;  // time to move one block
+
+    static DiskProfile HDD() { return {"HDD", 4.0, 0.1}; }
+    static DiskProfile SSD() { return {"SSD", 0.1, 0.02}; }
+    static DiskProfile NVMe() { return {"NVMe", 0.02, 0.004}; }
+};
+
+// Block geometry shared by every index and table: C-byte blocks, gamma-byte
+// keys and eta-byte child pointers. A data block holds rows of three
+// key-sized columns (the key plus attributes "a" and "b").
+struct BlockGeometry {
+    static constexpr int blockBytes = 512;   // C
+    static constexpr int keyBytes = 4;       // gamma
+    static constexpr int pointerBytes = 8;   // eta
+
+    static constexpr int bitsPerBlock = blockBytes * 8;
+    static constexpr int keysPerBlock = blockBytes / keyBytes;
+    static constexpr int rowsPerBlock = blockBytes / (3 * keyBytes);
+};
+
+// The plain counters, cheap to snapshot at the start of every query
+struct IOCounters {
+    long long readSeeks = 0;
+    long long readTransfers = 0;
+    long long writeSeeks = 0;
+    long long writeTransfers = 0;
+    long long queries = 0;
+};
+
+struct IOStats : IOCounters {
+    map<long long, long long> blocksPerQuery;   // blocks touched -> number of queries
+
+    long long seeks() const { return readSeeks + writeSeeks; }
+    long long transfers() const { return readTransfers + writeTransfers; }
+
+    double estimateMs(const DiskProfile& profile) const {
+        return seeks() * profile.seekMs + transfers() * profile.transferMs;
+    }
+
+    // Counters accrued since `earlier`; the histogram is not differenced
+    IOStats since(const IOCounters& earlier) const {
+        IOStats delta;
+        delta.readSeeks = readSeeks - earlier.readSeeks;
+        delta.readTransfers = readTransfers - earlier.readTransfers;
+        delta.writeSeeks = writeSeeks - earlier.writeSeeks;
+        delta.writeTransfers = writeTransfers - earlier.writeTransfers;
+        delta.queries = queries - earlier.queries;
+        return delta;
+    }
+
+    void add(const IOStats& other) {
+        readSeeks += other.readSeeks;
+        readTransfers += other.readTransfers;
+        writeSeeks += other.writeSeeks;
+        writeTransfers += other.writeTransfers;
+        queries += other.queries;
+        for (auto& bucket : other.blocksPerQuery) blocksPerQuery[bucket.first] += bucket.second;
+    }
+
+    string toJSON(const DiskProfile& profile) const {
+        ostringstream out;
+        out << "{\"seeks\":" << seeks() << ",\"transfers\":" << transfers()
+            << ",\"readSeeks\":" << readSeeks << ",\"readTransfers\":" << readTransfers
+            << ",\"writeSeeks\":" << writeSeeks << ",\"writeTransfers\":" << writeTransfers
+            << ",\"queries\":" << queries
+            << ",\"profile\":\"" << profile.name << "\",\"estimatedMs\":" << estimateMs(profile)
+            << ",\"blocksPerQuery\":{";
+        bool first = true;
+        for (auto& bucket : blocksPerQuery) {
+            out << (first ? "" : ",") << "\"" << bucket.first << "\":" << bucket.second;
+            first = false;
+        }
+        out << "}}";
+        return out.str();
+    }
+
+    static string csvHeader() {
+        return "label,seeks,transfers,read_seeks,read_transfers,write_seeks,write_transfers,queries,profile,estimated_ms";
+    }
+
+    string toCSV(const string& label, const DiskProfile& profile) const {
+        ostringstream out;
+        out << label << "," << seeks() << "," << transfers() << ","
+            << readSeeks << "," << readTransfers << "," << writeSeeks << "," << writeTransfers << ","
+            << queries << "," << profile.name << "," << estimateMs(profile);
+        return out.str();
+    }
+};
+
+// Counters and head position are kept per thread, so indexes driven from
+// different threads never share (or race on) a simulated disk arm.
+class DiskModel {
+private:
+    struct State {
+        IOStats stats;
+        long long currentBlock = -1;
+        bool parked = true;
+    };
+
+    static State& state() {
+        thread_local State s;
+        return s;
+    }
+
+public:
+    static void access(long long blockNum, AccessType type) {
+        State& s = state();
+        bool seek = s.parked || (blockNum != s.currentBlock && blockNum != s.currentBlock + 1);
+        if (type == AccessType::Read) {
+            s.stats.readTransfers++;
+            if (seek) s.stats.readSeeks++;
+        } else {
+            s.stats.writeTransfers++;
+            if (seek) s.stats.writeSeeks++;
+        }
+        s.currentBlock = blockNum;
+        s.parked = false;
+    }
+
+    // Forget the head position; the next access will be a seek
+    static void park() {
+        state().parked = true;
+    }
+
+    // Zero this thread's counters and park the head
+    static void reset() {
+        state().stats = IOStats();
+        park();
+    }
+
+    static const IOStats& stats() {
+        return state().stats;
+    }
+
+    static void recordQuery(long long blocks) {
+        State& s = state();
+        s.stats.queries++;
+        s.stats.blocksPerQuery[blocks]++;
+    }
+};
+
+inline void diskAccess(long long blockNum, AccessType type = AccessType::Read) {
+    DiskModel::access(blockNum, type);
+}
+
+// Attributes the accesses made while it is alive to one query; on
+// destruction the query's block count goes into the per-thread histogram.
+class IOScope {
+private:
+    IOCounters start;   // counters only, so opening a scope never copies the histogram
+
+public:
+    IOScope() : start(DiskModel::stats()) {}
+
+    ~IOScope() {
+        DiskModel::recordQuery(stats().transfers());
+    }
+
+    IOScope(const IOScope&) = delete;
+    IOScope& operator=(const IOScope&) = delete;
+
+    IOStats stats() const {
+        return DiskModel::stats().since(start);
+    }
+};
+
+#endif
@@ -1,122 +1,67 @@
-#include <iostream>
-#include <vector>
-#include <list>
-#include <unordered_map>
-
-using namespace std;
-
-// Metrics tracking
-int seekCount = 0;
-int transferCount = 0;
-int currentBlock = -1;
-
-class HashIndex {
-private:
-    struct Bucket {
-        vector<int> keys;
-        int overflowBlock = -1;
-    };
-
-    vector<Bucket> buckets;
-    int numBuckets;
-    int blockCapacity;
-    
-public:
-    HashIndex(int bucketsNum, int capacity) 
-        : numBuckets(bucketsNum), blockCapacity(capacity) {
-        buckets.resize(numBuckets);
-    }
-
-    // Simulate disk access operation
-    void diskAccess(int blockNum) {
-        transferCount++;
-        if (blockNum != currentBlock && blockNum != currentBlock + 1) {
-            seekCount++;
-        }
-        currentBlock = blockNum;
+#include <chrono>
+#include <random>
+#include <iomanip>
+
+#include "hashIndex.h"
+
+// Probe throughput of PagedHashIndex::searchBatch as the queue depth grows.
+// The probes are read with O_DIRECT, so every page comes from the device and
+// the curve shows how well it overlaps requests. Where O_DIRECT is refused
+// (e.g. tmpfs) the sweep falls back to buffered reads after evicting the
+// file from the page cache, which may not reach the device (see Readme.md).
+void queueDepthSweep(const string& path) {
+    const int buckets = 16384;
+    const int capacity = 1022;        // 4 KiB pages, 64 MiB file
+    const int keys = 200000;
+    const int batchSize = 4096;
+
+    mt19937_64 rng(42);
+    uniform_int_distribution<int> keyDist(0, 4 * keys - 1);
+    PagedHashIndex* paged = PagedHashIndex::create(path, buckets, capacity);
+    for (int i = 0; i < keys; i++) paged->insert(keyDist(rng));
+    paged->close();
+    delete paged;
+
+    vector<int> probes(batchSize);
+    for (int& k : probes) k = keyDist(rng);
+
+    bool direct = true;
+    try {
+        delete PagedHashIndex::open(path, 1, true);
+    } catch (const exception&) {
+        direct = false;
     }
 
-    // Hash function using modulo (static hashing)
-    int hashFunction(int key) {
-        return key % numBuckets;
-    }
-
-    // Insert key with overflow handling
-    void insert(int key) {
-        int bucketIdx = hashFunction(key);
-        Bucket& primary = buckets[bucketIdx];
-        
-        // Check primary bucket
-        if (primary.keys.size() < blockCapacity) {
-            primary.keys.push_back(key);
-            diskAccess(bucketIdx);
-            return; 
-        }
-
-        // Handle overflow
-        int currentBlock = bucketIdx;
-        while (buckets[currentBlock].overflowBlock != -1) {
-            currentBlock = buckets[currentBlock].overflowBlock;
-            diskAccess(currentBlock);
-        }
-
-        if (buckets[currentBlock].keys.size() < blockCapacity) {
-            buckets[currentBlock].keys.push_back(key);
-            diskAccess(currentBlock);
-        } else {
-            // Create new overflow block
-            Bucket newBucket;
-            newBucket.keys.push_back(key);
-            buckets.push_back(newBucket);
-            buckets[currentBlock].overflowBlock = buckets.size() - 1;
-            diskAccess(buckets.size() - 1);
-        }
-    }
-
-    // Search for key with metrics
-    pair<bool, int> search(int key) {
-        int operations = 0;
-        int bucketIdx = hashFunction(key);
-        int currentBlock = bucketIdx;
-        int overflowChain = 0;
-
-        do {
-            operations++;
-            diskAccess(currentBlock);
-            
-            // Check current block
-            for (int k : buckets[currentBlock].keys) {
-                if (k == key) {
-                    return {true, operations};
+    cout << "\nQueue depth sweep (" << batchSize << " probes, " << buckets << " pages of 4 KiB, "
+         << (direct ? "O_DIRECT" : "buffered, O_DIRECT unavailable") << "):\n";
+    cout << "depth    keys/s       ms\n";
+    for (int depth : {1, 2, 4, 8, 16, 32, 64, 128}) {
+        // Median of three cold runs
+        vector<double> runs;
+        for (int r = 0; r < 3; r++) {
+            if (!direct) {
+                int cacheFd = ::open(path.c_str(), O_RDONLY);
+                if (cacheFd >= 0) {
+                    posix_fadvise(cacheFd, 0, 0, POSIX_FADV_DONTNEED);
+                    ::close(cacheFd);
                 }
             }
 
-            // Follow overflow chain
-            currentBlock = buckets[currentBlock].overflowBlock;
-            if (currentBlock != -1) overflowChain++;
-        } while (currentBlock != -1);
-
-        return {false, operations};
-    }
-
-    // Print index structure
-    void printStructure() {
-        for (int i = 0; i < numBuckets; ++i) {
-            cout << "Bucket " << i << ": [";
-            for (int k : buckets[i].keys) cout << k << " ";
-            cout << "]";
-            
-            int overflow = buckets[i].overflowBlock;
-            while (overflow != -1) {
-                cout << " -> Overflow " << overflow << ": [";
-                for (int k : buckets[overflow].keys) cout << k << " ";
-                cout << "]";
-                overflow = buckets[overflow].overflowBlock;
-            }
-            cout << endl;
+            paged = PagedHashIndex::open(path, depth, direct);
+            auto start = chrono::steady_clock::now();
+            paged->searchBatch(probes);
+            runs.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+            delete paged;
         }
+        sort(runs.begin(), runs.end());
+        double ms = runs[1];
+
+        cout << setw(5) << depth << setw(10) << (long long)(batchSize / (ms / 1000))
+             << setw(9) << fixed << setprecision(2) << ms << endl;
+        cout.unsetf(ios::floatfield);
     }
-};
+    remove(path.c_str());
+}
 
 int main() {
     // Initialize hash index with 5 buckets and capacity of 3 keys/block
@@ -142,13 +87,49 @@ int main() {
     hi.printStructure();
     
     cout << "\nMetrics Summary:\n";
-    cout << "Total seeks: " << seekCount << endl;
-    cout << "Total transfers: " << transferCount << endl;
+    cout << "Total seeks: " << DiskModel::stats().seeks() << endl;
+    cout << "Total transfers: " << DiskModel::stats().transfers() << endl;
     cout << "Search operations:\n";
     cout << "35 found: " << boolalpha << found1 
          << " (Blocks checked: " << ops1 << ")\n";
     cout << "50 found: " << found2 
          << " (Blocks checked: " << ops2 << ")\n";
 
+    // Same data, persisted to a page file and probed as one batch
+    DiskModel::reset();
+
+    const string indexFile = "hashIndex.dat";
+    PagedHashIndex* paged = PagedHashIndex::create(indexFile, 5, 3);
+    for (int k : data) {
+        paged->insert(k);
+    }
+    paged->close();
+    delete paged;
+
+    DiskModel::reset();
+
+    paged = PagedHashIndex::open(indexFile);
+    vector<int> probes = {35, 50, 103, 14, 71};
+    vector<pair<bool, int>> batch;
+    {
+        IOScope query;
+        batch = paged->searchBatch(probes);
+    }
+
+    cout << "\nPaged Index (" << paged->pageCount() << " pages, "
+         << (paged->usingIoUring() ? "io_uring" : "pread pool") << "):\n";
+    for (size_t i = 0; i < probes.size(); i++) {
+        cout << probes[i] << " found: " << batch[i].first
+             << " (Blocks checked: " << batch[i].second << ")\n";
+    }
+    cout << "Batch seeks: " << DiskModel::stats().seeks() << endl;
+    cout << "Batch transfers: " << DiskModel::stats().transfers() << endl;
+    cout << "Batch I/O (SSD): " << DiskModel::stats().toJSON(DiskProfile::SSD()) << endl;
+
+    delete paged;
+    remove(indexFile.c_str());
+
+    queueDepthSweep(indexFile);
+
     return 0;
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,687 @@
+#ifndef HASH_INDEX_H
+#define HASH_INDEX_H
+
+#include <iostream>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <cerrno>
+#include <algorithm>
+#include <tuple>
+#include <atomic>
+#include <thread>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+#include "diskModel.h"
+
+using namespace std;
+
+class HashIndex {
+private:
+    struct Bucket {
+        vector<int> keys;
+        vector<int> rowIds;      // row of each key, -1 when not tracked
+        int overflowBlock = -1;
+    };
+
+    vector<Bucket> buckets;
+    int numBuckets;
+    int blockCapacity;
+    
+public:
+    HashIndex(int bucketsNum, int capacity) 
+        : numBuckets(bucketsNum), blockCapacity(capacity) {
+        buckets.resize(numBuckets);
+    }
+
+    // Hash function using modulo (static hashing); negative keys wrap
+    // around so the bucket is always in [0, numBuckets)
+    int hashFunction(int key) {
+        return ((key % numBuckets) + numBuckets) % numBuckets;
+    }
+
+    // Insert key with overflow handling. Every block that changes is read
+    // and then written back, like PagedHashIndex::insert.
+    void insert(int key, int rowId = -1) {
+        int currentBlock = hashFunction(key);
+        diskAccess(currentBlock);
+
+        // Walk to the last block of the chain
+        while (buckets[currentBlock].keys.size() == blockCapacity && buckets[currentBlock].overflowBlock != -1) {
+            currentBlock = buckets[currentBlock].overflowBlock;
+            diskAccess(currentBlock);
+        }
+
+        if (buckets[currentBlock].keys.size() < blockCapacity) {
+            buckets[currentBlock].keys.push_back(key);
+            buckets[currentBlock].rowIds.push_back(rowId);
+            diskAccess(currentBlock, AccessType::Write);
+            return;
+        }
+
+        // Create new overflow block, then link it from the last block
+        Bucket newBucket;
+        newBucket.keys.push_back(key);
+        newBucket.rowIds.push_back(rowId);
+        buckets.push_back(newBucket);
+        int newBlock = buckets.size() - 1;
+        diskAccess(newBlock, AccessType::Write);
+        buckets[currentBlock].overflowBlock = newBlock;
+        diskAccess(currentBlock, AccessType::Write);
+    }
+
+    // Search for key with metrics
+    pair<bool, int> search(int key) {
+        int operations = 0;
+        int bucketIdx = hashFunction(key);
+        int currentBlock = bucketIdx;
+        int overflowChain = 0;
+
+        do {
+            operations++;
+            diskAccess(currentBlock);
+            
+            // Check current block
+            for (int k : buckets[currentBlock].keys) {
+                if (k == key) {
+                    return {true, operations};
+                }
+            }
+
+            // Follow overflow chain
+            currentBlock = buckets[currentBlock].overflowBlock;
+            if (currentBlock != -1) overflowChain++;
+        } while (currentBlock != -1);
+
+        return {false, operations};
+    }
+
+    // Rows of every entry with this key; duplicates force a walk of the whole chain
+    vector<int> lookup(int key) {
+        vector<int> rows;
+        int currentBlock = hashFunction(key);
+        while (currentBlock != -1) {
+            diskAccess(currentBlock);
+            const Bucket& bucket = buckets[currentBlock];
+            for (size_t i = 0; i < bucket.keys.size(); i++) {
+                if (bucket.keys[i] == key) rows.push_back(bucket.rowIds[i]);
+            }
+            currentBlock = bucket.overflowBlock;
+        }
+        return rows;
+    }
+
+    // Probe many keys at once. Keys are visited in bucket order, so primary
+    // blocks are read front to back, and keys sharing a bucket share one
+    // pass over its chain. Matches are (position in keys, rowId).
+    void lookupBatch(const vector<int>& keys, vector<pair<int, int>>& matches) {
+        vector<tuple<int, int, int>> order;     // bucket, key, position
+        order.reserve(keys.size());
+        for (size_t i = 0; i < keys.size(); i++) order.emplace_back(hashFunction(keys[i]), keys[i], i);
+        sort(order.begin(), order.end());
+
+        size_t first = 0;
+        while (first < order.size()) {
+            int bucketIdx = get<0>(order[first]);
+            size_t last = first;
+            while (last < order.size() && get<0>(order[last]) == bucketIdx) last++;
+
+            for (int block = bucketIdx; block != -1; block = buckets[block].overflowBlock) {
+                diskAccess(block);
+                const Bucket& bucket = buckets[block];
+                for (size_t k = 0; k < bucket.keys.size(); k++) {
+                    auto probes = equal_range(order.begin() + first, order.begin() + last,
+                                              make_tuple(bucketIdx, bucket.keys[k], 0),
+                                              [](const tuple<int, int, int>& x, const tuple<int, int, int>& y) {
+                                                  return get<1>(x) < get<1>(y);
+                                              });
+                    for (auto it = probes.first; it != probes.second; ++it) {
+                        matches.push_back({get<2>(*it), bucket.rowIds[k]});
+                    }
+                }
+            }
+            first = last;
+        }
+    }
+
+    // Approximate in-memory footprint of the buckets and their keys
+    size_t memoryBytes() const {
+        size_t bytes = sizeof(*this) + buckets.capacity() * sizeof(Bucket);
+        for (const Bucket& b : buckets) bytes += (b.keys.capacity() + b.rowIds.capacity()) * sizeof(int);
+        return bytes;
+    }
+
+    int bucketCount() const {
+        return numBuckets;
+    }
+
+    // Primary plus overflow blocks
+    int blockCount() const {
+        return buckets.size();
+    }
+
+    int capacity() const {
+        return blockCapacity;
+    }
+
+    // Print index structure
+    void printStructure() {
+        for (int i = 0; i < numBuckets; ++i) {
+            cout << "Bucket " << i << ": [";
+            for (int k : buckets[i].keys) cout << k << " ";
+            cout << "]";
+            
+            int overflow = buckets[i].overflowBlock;
+            while (overflow != -1) {
+                cout << " -> Overflow " << overflow << ": [";
+                for (int k : buckets[overflow].keys) cout << k << " ";
+                cout << "]";
+                overflow = buckets[overflow].overflowBlock;
+            }
+            cout << endl;
+        }
+    }
+};
+
+// Raw io_uring ring used to submit a whole batch of page reads at once.
+// Talks to the kernel directly so no liburing dependency is needed; if the
+// kernel or sandbox refuses io_uring_setup, ok() stays false and callers
+// fall back to the pread thread-pool.
+class IoUring {
+private:
+    int ringFd = -1;
+    unsigned entries = 0;
+    void* sqRing = MAP_FAILED;
+    void* cqRing = MAP_FAILED;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    io_uring_sqe* sqes = (io_uring_sqe*)MAP_FAILED;
+    size_t sqesSize = 0;
+
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqMask = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned* cqMask = nullptr;
+    io_uring_cqe* cqes = nullptr;
+
+    void release() {
+        if (sqes != MAP_FAILED) munmap(sqes, sqesSize);
+        if (cqRing != MAP_FAILED && cqRing != sqRing) munmap(cqRing, cqRingSize);
+        if (sqRing != MAP_FAILED) munmap(sqRing, sqRingSize);
+        if (ringFd >= 0) close(ringFd);
+        sqes = (io_uring_sqe*)MAP_FAILED;
+        sqRing = cqRing = MAP_FAILED;
+        ringFd = -1;
+    }
+
+public:
+    IoUring(unsigned depth) {
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        ringFd = (int)syscall(__NR_io_uring_setup, depth, &params);
+        if (ringFd < 0) return;
+        entries = params.sq_entries;
+
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMmap) sqRingSize = cqRingSize = max(sqRingSize, cqRingSize);
+
+        sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ringFd, IORING_OFF_SQ_RING);
+        if (sqRing == MAP_FAILED) { release(); return; }
+        cqRing = singleMmap ? sqRing
+                            : mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                   ringFd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED) { release(); return; }
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        sqes = (io_uring_sqe*)mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                   ringFd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) { release(); return; }
+
+        char* sq = (char*)sqRing;
+        char* cq = (char*)cqRing;
+        sqHead = (unsigned*)(sq + params.sq_off.head);
+        sqTail = (unsigned*)(sq + params.sq_off.tail);
+        sqMask = (unsigned*)(sq + params.sq_off.ring_mask);
+        sqArray = (unsigned*)(sq + params.sq_off.array);
+        cqHead = (unsigned*)(cq + params.cq_off.head);
+        cqTail = (unsigned*)(cq + params.cq_off.tail);
+        cqMask = (unsigned*)(cq + params.cq_off.ring_mask);
+        cqes = (io_uring_cqe*)(cq + params.cq_off.cqes);
+    }
+
+    ~IoUring() { release(); }
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    bool ok() const { return ringFd >= 0; }
+
+    // Read every (offset -> buffer) request, keeping up to `entries` reads in
+    // flight. Returns only once the kernel holds no pointer into `buffers`, so
+    // on failure the caller may reuse them for a fallback.
+    bool readAll(int fd, const vector<off_t>& offsets, const vector<char*>& buffers, size_t length) {
+        size_t total = offsets.size();
+        size_t queued = 0, completed = 0;   // queued counts SQEs placed in the ring
+        bool success = true;
+        bool stopped = false;               // set on a submit error: queue nothing more
+
+        while (completed < queued || (!stopped && queued < total)) {
+            unsigned tail = *sqTail;
+            while (!stopped && queued < total && queued - completed < entries) {
+                unsigned idx = tail & *sqMask;
+                io_uring_sqe* sqe = &sqes[idx];
+                memset(sqe, 0, sizeof(*sqe));
+                sqe->opcode = IORING_OP_READ;
+                sqe->fd = fd;
+                sqe->off = offsets[queued];
+                sqe->addr = (unsigned long)buffers[queued];
+                sqe->len = length;
+                sqe->user_data = queued;
+                sqArray[idx] = idx;
+                tail++;
+                queued++;
+            }
+            __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+
+            // Submit everything the kernel has not consumed yet, including
+            // entries left over from an earlier partial submit
+            unsigned unsubmitted = tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+            if (unsubmitted > 0) {
+                int ret = (int)syscall(__NR_io_uring_enter, ringFd, unsubmitted, 0, 0, nullptr, 0);
+                if (ret < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                    // Withdraw the entries the kernel never saw, then drain the rest
+                    unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+                    queued -= tail - head;
+                    __atomic_store_n(sqTail, head, __ATOMIC_RELEASE);
+                    stopped = true;
+                    success = false;
+                }
+            }
+
+            // Only wait when the kernel owns reads, otherwise GETEVENTS blocks forever
+            size_t pendingSubmit = *sqTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+            size_t inKernel = queued - completed - pendingSubmit;
+            if (inKernel > 0 && __atomic_load_n(cqTail, __ATOMIC_ACQUIRE) == *cqHead) {
+                int ret = (int)syscall(__NR_io_uring_enter, ringFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                if (ret < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                    // Cannot sleep on the ring; the reads still complete, so poll for them
+                    while (__atomic_load_n(cqTail, __ATOMIC_ACQUIRE) == *cqHead) this_thread::yield();
+                }
+            }
+
+            unsigned head = *cqHead;
+            while (head != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+                io_uring_cqe* cqe = &cqes[head & *cqMask];
+                if (cqe->res != (int)length) success = false;
+                head++;
+                completed++;
+            }
+            __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+        }
+        return success;
+    }
+};
+
+// Disk-resident variant of HashIndex. Page 0 is a header recording the
+// geometry, pages 1..numBuckets are the primary buckets and overflow pages are
+// appended at the end of the file. Every page has the same fixed size:
+//   [count][overflowPage][key 0] ... [key blockCapacity-1]
+class PagedHashIndex {
+private:
+    static const int32_t MAGIC = 0x48494458; // "HIDX"
+    static const int HEADER_FIELDS = 4;      // magic, numBuckets, blockCapacity, numPages
+
+    struct Page {
+        vector<int32_t> words;
+
+        int32_t& count() { return words[0]; }
+        int32_t& overflowPage() { return words[1]; }
+        int32_t* keys() { return words.data() + 2; }
+    };
+
+    int fd;
+    int numBuckets;
+    int blockCapacity;
+    int numPages;
+    size_t pageBytes;
+    int queueDepth;
+    bool direct = false;
+    IoUring ring;
+
+    // O_DIRECT needs buffers, offsets and lengths aligned to the device's
+    // logical block; 4096 bytes covers the common devices
+    static const size_t DIRECT_ALIGN = 4096;
+
+    // Page-aligned scratch memory for O_DIRECT transfers
+    struct AlignedBuffer {
+        char* data = nullptr;
+
+        AlignedBuffer(size_t bytes) {
+            if (posix_memalign((void**)&data, DIRECT_ALIGN, bytes) != 0) throw bad_alloc();
+        }
+        ~AlignedBuffer() { free(data); }
+
+        AlignedBuffer(const AlignedBuffer&) = delete;
+        AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+    };
+
+    int primaryPage(int key) {
+        return 1 + ((key % numBuckets) + numBuckets) % numBuckets;
+    }
+
+    Page newPage() {
+        Page page;
+        page.words.assign(pageBytes / sizeof(int32_t), 0);
+        page.overflowPage() = -1;
+        return page;
+    }
+
+    // Reject a page whose key count overruns it or whose overflow link does
+    // not point forward into the file. Overflow pages are only ever appended,
+    // so a valid chain strictly increases and cannot loop.
+    void checkPage(int pageId, Page& page) {
+        int count = page.count();
+        int overflow = page.overflowPage();
+        bool valid = count >= 0 && count <= blockCapacity &&
+                     (overflow == -1 || (overflow > max(pageId, numBuckets) && overflow < numPages));
+        if (!valid) throw runtime_error("corrupt page " + to_string(pageId));
+    }
+
+    // Whole-page transfers; under O_DIRECT they bounce through aligned memory
+    bool readBytes(void* dst, off_t offset) {
+        if (!direct) return pread(fd, dst, pageBytes, offset) == (ssize_t)pageBytes;
+        AlignedBuffer buffer(pageBytes);
+        if (pread(fd, buffer.data, pageBytes, offset) != (ssize_t)pageBytes) return false;
+        memcpy(dst, buffer.data, pageBytes);
+        return true;
+    }
+
+    bool writeBytes(const void* src, off_t offset) {
+        if (!direct) return pwrite(fd, src, pageBytes, offset) == (ssize_t)pageBytes;
+        AlignedBuffer buffer(pageBytes);
+        memcpy(buffer.data, src, pageBytes);
+        return pwrite(fd, buffer.data, pageBytes, offset) == (ssize_t)pageBytes;
+    }
+
+    void readPage(int pageId, Page& page) {
+        page.words.resize(pageBytes / sizeof(int32_t));
+        if (!readBytes(page.words.data(), (off_t)pageId * pageBytes)) {
+            throw runtime_error("short read of page " + to_string(pageId));
+        }
+        diskAccess(pageId);
+        checkPage(pageId, page);
+    }
+
+    void writePage(int pageId, Page& page) {
+        if (!writeBytes(page.words.data(), (off_t)pageId * pageBytes)) {
+            throw runtime_error("short write of page " + to_string(pageId));
+        }
+        diskAccess(pageId, AccessType::Write);
+    }
+
+    void writeHeader() {
+        Page header = newPage();
+        header.words[0] = MAGIC;
+        header.words[1] = numBuckets;
+        header.words[2] = blockCapacity;
+        header.words[3] = numPages;
+        if (!writeBytes(header.words.data(), 0)) {
+            throw runtime_error("failed to write index header");
+        }
+    }
+
+    // Fetch all pages of one probe round. io_uring gets them in a single
+    // submission; otherwise a pool of queueDepth threads issues preads.
+    // Under O_DIRECT the round is read into one aligned buffer and copied out.
+    void readPages(const vector<int>& pageIds, vector<Page>& pages) {
+        pages.assign(pageIds.size(), Page());
+        vector<off_t> offsets(pageIds.size());
+        vector<char*> buffers(pageIds.size());
+        unique_ptr<AlignedBuffer> aligned(direct ? new AlignedBuffer(pageIds.size() * pageBytes) : nullptr);
+        for (size_t i = 0; i < pageIds.size(); i++) {
+            pages[i].words.resize(pageBytes / sizeof(int32_t));
+            offsets[i] = (off_t)pageIds[i] * pageBytes;
+            buffers[i] = direct ? aligned->data + i * pageBytes : (char*)pages[i].words.data();
+        }
+
+        bool done = ring.ok() && ring.readAll(fd, offsets, buffers, pageBytes);
+        if (!done) {
+            atomic<size_t> next(0);
+            atomic<bool> failed(false);
+            auto worker = [&]() {
+                size_t i;
+                while ((i = next++) < pageIds.size()) {
+                    if (pread(fd, buffers[i], pageBytes, offsets[i]) != (ssize_t)pageBytes) failed = true;
+                }
+            };
+            int threads = min((int)pageIds.size(), queueDepth);
+            vector<thread> pool;
+            for (int t = 1; t < threads; t++) pool.emplace_back(worker);
+            worker();
+            for (thread& t : pool) t.join();
+            if (failed) throw runtime_error("short read during batch probe");
+        }
+
+        if (direct) {
+            for (size_t i = 0; i < pageIds.size(); i++) memcpy(pages[i].words.data(), buffers[i], pageBytes);
+        }
+
+        // The reads are issued together, so account for them in page order
+        for (int pageId : pageIds) diskAccess(pageId);
+        for (size_t i = 0; i < pageIds.size(); i++) checkPage(pageIds[i], pages[i]);
+    }
+
+    PagedHashIndex(int fileFd, int bucketsNum, int capacity, int pages, int depth)
+        : fd(fileFd), numBuckets(bucketsNum), blockCapacity(capacity), numPages(pages),
+          pageBytes(sizeof(int32_t) * (2 + capacity)), queueDepth(max(1, depth)), ring(max(1, depth)) {}
+
+    // Switch the open file to O_DIRECT so page reads bypass the page cache
+    void enableDirectIO() {
+        if (pageBytes % DIRECT_ALIGN != 0) {
+            throw invalid_argument("O_DIRECT needs pages that are a multiple of " + to_string(DIRECT_ALIGN) + " bytes");
+        }
+        int flags = fcntl(fd, F_GETFL);
+        if (flags < 0 || fcntl(fd, F_SETFL, flags | O_DIRECT) != 0) {
+            throw runtime_error("O_DIRECT is not supported for this file");
+        }
+        direct = true;
+    }
+
+public:
+    // Create a fresh index file, overwriting any existing one. With `directIO`
+    // every page transfer uses O_DIRECT; the page size must then be a
+    // multiple of 4096 bytes (blockCapacity = 1022, 2046, ...).
+    static PagedHashIndex* create(const string& path, int bucketsNum, int capacity, int depth = 32,
+                                  bool directIO = false) {
+        if (capacity < HEADER_FIELDS - 2) {
+            throw invalid_argument("block capacity too small to hold the header");
+        }
+        if (bucketsNum < 1) throw invalid_argument("hash index needs at least one bucket");
+        int fileFd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fileFd < 0) throw runtime_error("cannot create " + path);
+
+        PagedHashIndex* index = new PagedHashIndex(fileFd, bucketsNum, capacity, 1 + bucketsNum, depth);
+        try {
+            if (directIO) index->enableDirectIO();
+            index->writeHeader();
+            Page empty = index->newPage();
+            for (int b = 0; b < bucketsNum; b++) index->writePage(1 + b, empty);
+        } catch (...) {
+            delete index;
+            throw;
+        }
+        return index;
+    }
+
+    // Reopen an index file written by create(), optionally with O_DIRECT
+    static PagedHashIndex* open(const string& path, int depth = 32, bool directIO = false) {
+        int fileFd = ::open(path.c_str(), O_RDWR);
+        if (fileFd < 0) throw runtime_error("cannot open " + path);
+
+        int32_t header[HEADER_FIELDS];
+        if (pread(fileFd, header, sizeof(header), 0) != (ssize_t)sizeof(header) || header[0] != MAGIC) {
+            ::close(fileFd);
+            throw runtime_error(path + " is not a hash index file");
+        }
+
+        // Reject geometry that would divide by zero or read past the file
+        int bucketsNum = header[1], capacity = header[2], pages = header[3];
+        struct stat info;
+        bool valid = bucketsNum > 0 && capacity >= HEADER_FIELDS - 2 && pages > bucketsNum &&
+                     fstat(fileFd, &info) == 0 &&
+                     info.st_size >= (off_t)pages * (off_t)(sizeof(int32_t) * (2 + (size_t)capacity));
+        if (!valid) {
+            ::close(fileFd);
+            throw runtime_error(path + " has a corrupt hash index header");
+        }
+        PagedHashIndex* index = new PagedHashIndex(fileFd, bucketsNum, capacity, pages, depth);
+        if (directIO) {
+            try {
+                index->enableDirectIO();
+            } catch (...) {
+                delete index;
+                throw;
+            }
+        }
+        return index;
+    }
+
+    // The header is rewritten whenever numPages changes, so the destructor
+    // only releases the file; call close() to learn whether it reached disk.
+    ~PagedHashIndex() {
+        if (fd >= 0) ::close(fd);
+    }
+
+    PagedHashIndex(const PagedHashIndex&) = delete;
+    PagedHashIndex& operator=(const PagedHashIndex&) = delete;
+
+    // Insert key, appending an overflow page when the chain is full
+    void insert(int key) {
+        int pageId = primaryPage(key);
+        Page page;
+        readPage(pageId, page);
+
+        while (page.count() == blockCapacity && page.overflowPage() != -1) {
+            pageId = page.overflowPage();
+            readPage(pageId, page);
+        }
+
+        if (page.count() < blockCapacity) {
+            page.keys()[page.count()++] = key;
+            writePage(pageId, page);
+            return;
+        }
+
+        // Create new overflow page at the end of the file
+        int newPageId = numPages++;
+        Page overflow = newPage();
+        overflow.keys()[overflow.count()++] = key;
+        writePage(newPageId, overflow);
+        page.overflowPage() = newPageId;
+        writePage(pageId, page);
+        writeHeader();
+    }
+
+    // Search one key, returning whether it was found and pages checked
+    pair<bool, int> search(int key) {
+        int operations = 0;
+        int pageId = primaryPage(key);
+        Page page;
+
+        while (pageId != -1) {
+            operations++;
+            readPage(pageId, page);
+            for (int i = 0; i < page.count(); i++) {
+                if (page.keys()[i] == key) return {true, operations};
+            }
+            pageId = page.overflowPage();
+        }
+        return {false, operations};
+    }
+
+    // Search many keys at once. Round 0 reads every primary page together,
+    // each later round reads the next overflow page of the keys still pending.
+    vector<pair<bool, int>> searchBatch(const vector<int>& keys) {
+        vector<pair<bool, int>> results(keys.size(), {false, 0});
+        vector<int> nextPage(keys.size());
+        vector<size_t> pending(keys.size());
+        for (size_t i = 0; i < keys.size(); i++) {
+            nextPage[i] = primaryPage(keys[i]);
+            pending[i] = i;
+        }
+
+        while (!pending.empty()) {
+            // Keys sharing a bucket share one read
+            vector<int> pageIds;
+            for (size_t i : pending) pageIds.push_back(nextPage[i]);
+            sort(pageIds.begin(), pageIds.end());
+            pageIds.erase(unique(pageIds.begin(), pageIds.end()), pageIds.end());
+
+            vector<Page> pages;
+            readPages(pageIds, pages);
+
+            vector<size_t> stillPending;
+            for (size_t i : pending) {
+                size_t slot = lower_bound(pageIds.begin(), pageIds.end(), nextPage[i]) - pageIds.begin();
+                Page& page = pages[slot];
+                results[i].second++;
+
+                bool found = false;
+                for (int k = 0; k < page.count(); k++) {
+                    if (page.keys()[k] == keys[i]) {
+                        found = true;
+                        break;
+                    }
+                }
+
+                if (found) {
+                    results[i].first = true;
+                } else if (page.overflowPage() != -1) {
+                    nextPage[i] = page.overflowPage();
+                    stillPending.push_back(i);
+                }
+            }
+            pending.swap(stillPending);
+        }
+        return results;
+    }
+
+    // Persist the header and sync the file; throws if either fails
+    void flush() {
+        writeHeader();
+        if (fsync(fd) != 0) throw runtime_error("failed to sync index file");
+    }
+
+    // Flush and release the file. The index is unusable afterwards.
+    void close() {
+        flush();
+        int fileFd = fd;
+        fd = -1;
+        if (::close(fileFd) != 0) throw runtime_error("failed to close index file");
+    }
+
+    bool usingIoUring() const { return ring.ok(); }
+
+    bool usingDirectIO() const { return direct; }
+
+    int pageCount() const { return numPages; }
+};
+
+#endif
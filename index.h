@@ -0,0 +1,472 @@
+#ifndef INDEX_H
+#define INDEX_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "diskModel.h"
+#include "table.h"
+#include "hashIndex.h"
+#include "btreeIndex.h"
+#include "bitmapIndex.h"
+
+using namespace std;
+
+// Common interface over the three index structures plus a full table scan,
+// so they can be linked into one program and compared per predicate.
+
+struct Predicate {
+    enum Kind { Equal, Range, And, Or };
+
+    Kind kind = Equal;
+    string column;            // Equal / Range
+    int low = 0;
+    int high = 0;
+    vector<Predicate> terms;  // And / Or
+
+    static Predicate equal(const string& column, int value) {
+        Predicate p;
+        p.kind = Equal;
+        p.column = column;
+        p.low = p.high = value;
+        return p;
+    }
+
+    static Predicate between(const string& column, int low, int high) {
+        Predicate p;
+        p.kind = Range;
+        p.column = column;
+        p.low = low;
+        p.high = high;
+        return p;
+    }
+
+    static Predicate both(const Predicate& left, const Predicate& right) {
+        Predicate p;
+        p.kind = And;
+        p.terms = {left, right};
+        return p;
+    }
+
+    static Predicate either(const Predicate& left, const Predicate& right) {
+        Predicate p;
+        p.kind = Or;
+        p.terms = {left, right};
+        return p;
+    }
+
+    bool matches(const Row& row) const {
+        switch (kind) {
+            case Equal: return columnValue(row, column) == low;
+            case Range: {
+                int v = columnValue(row, column);
+                return v >= low && v <= high;
+            }
+            case And: return terms[0].matches(row) && terms[1].matches(row);
+            case Or: return terms[0].matches(row) || terms[1].matches(row);
+        }
+        return false;
+    }
+
+    string describe() const {
+        switch (kind) {
+            case Equal: return column + "=" + to_string(low);
+            case Range: return column + " in [" + to_string(low) + "," + to_string(high) + "]";
+            case And: return terms[0].describe() + " AND " + terms[1].describe();
+            case Or: return terms[0].describe() + " OR " + terms[1].describe();
+        }
+        return "";
+    }
+};
+
+// Predicted I/O of answering one predicate through one access path
+struct CostEstimate {
+    bool supported = true;
+    double seeks = 0;
+    double transfers = 0;
+
+    double ms(const DiskProfile& profile) const {
+        return supported ? seeks * profile.seekMs + transfers * profile.transferMs : INFINITY;
+    }
+
+    static CostEstimate unsupported() {
+        CostEstimate c;
+        c.supported = false;
+        return c;
+    }
+};
+
+// Per-column statistics: cardinality, an equi-depth histogram for ranges and
+// exact value counts when the column has few distinct values.
+struct ColumnStats {
+    static const long long EXACT_LIMIT = 1024;
+
+    long long rows = 0;
+    long long distinct = 0;
+    int minValue = 0;
+    int maxValue = 0;
+    vector<int> bounds;                  // bounds[i] = largest value in bucket i
+    map<int, long long> frequencies;     // only filled when distinct <= EXACT_LIMIT
+
+    static ColumnStats build(const vector<int>& values, int buckets = 64) {
+        ColumnStats s;
+        s.rows = values.size();
+        if (values.empty()) return s;
+
+        vector<int> sorted(values);
+        sort(sorted.begin(), sorted.end());
+        s.minValue = sorted.front();
+        s.maxValue = sorted.back();
+        for (size_t i = 0; i < sorted.size(); i++) {
+            if (i == 0 || sorted[i] != sorted[i - 1]) s.distinct++;
+        }
+        if (s.distinct <= EXACT_LIMIT) {
+            for (int v : sorted) s.frequencies[v]++;
+        }
+
+        buckets = (int)min<long long>(buckets, s.rows);
+        for (int b = 1; b <= buckets; b++) {
+            s.bounds.push_back(sorted[(long long)b * s.rows / buckets - 1]);
+        }
+        return s;
+    }
+
+    // Fraction of rows whose value is <= x, interpolating inside a bucket
+    double fractionAtMost(double x) const {
+        if (rows == 0 || x < minValue) return 0;
+        if (x >= maxValue) return 1;
+        size_t i = lower_bound(bounds.begin(), bounds.end(), x) - bounds.begin();
+        double lo = i == 0 ? minValue - 1 : bounds[i - 1];
+        double hi = bounds[i];
+        double within = hi > lo ? (x - lo) / (hi - lo) : 1.0;
+        return (i + within) / bounds.size();
+    }
+
+    double equalSelectivity(int value) const {
+        if (rows == 0) return 0;
+        if (!frequencies.empty()) {
+            auto it = frequencies.find(value);
+            return it == frequencies.end() ? 0 : (double)it->second / rows;
+        }
+        if (value < minValue || value > maxValue) return 0;
+        return 1.0 / distinct;
+    }
+
+    double rangeSelectivity(int low, int high) const {
+        if (rows == 0 || high < low) return 0;
+        if (!frequencies.empty()) {
+            long long count = 0;
+            for (auto it = frequencies.lower_bound(low); it != frequencies.end() && it->first <= high; ++it) {
+                count += it->second;
+            }
+            return (double)count / rows;
+        }
+        return max(0.0, fractionAtMost(high) - fractionAtMost((double)low - 1));
+    }
+};
+
+typedef map<string, ColumnStats> StatsCatalog;
+
+inline StatsCatalog buildCatalog(const Table& table) {
+    StatsCatalog catalog;
+    for (const char* column : {"key", "a", "b"}) {
+        catalog[column] = ColumnStats::build(table.column(column));
+    }
+    return catalog;
+}
+
+// Fraction of rows satisfying the predicate; conjuncts are assumed independent
+inline double selectivity(const Predicate& p, const StatsCatalog& stats) {
+    switch (p.kind) {
+        case Predicate::Equal: return stats.at(p.column).equalSelectivity(p.low);
+        case Predicate::Range: return stats.at(p.column).rangeSelectivity(p.low, p.high);
+        case Predicate::And: return selectivity(p.terms[0], stats) * selectivity(p.terms[1], stats);
+        case Predicate::Or: {
+            double l = selectivity(p.terms[0], stats), r = selectivity(p.terms[1], stats);
+            return l + r - l * r;
+        }
+    }
+    return 1;
+}
+
+inline long long estimatedRows(const Predicate& p, const StatsCatalog& stats) {
+    if (stats.empty()) return 0;
+    return llround(selectivity(p, stats) * stats.begin()->second.rows);
+}
+
+class Index {
+public:
+    virtual ~Index() {}
+
+    virtual string name() const = 0;
+
+    // Rows whose key equals `key`
+    virtual vector<int> lookup(int key) = 0;
+
+    // Rows whose key lies in [low, high]
+    virtual vector<int> range(int low, int high) = 0;
+
+    // Rows satisfying an arbitrary predicate this path supports
+    virtual vector<int> evaluate(const Predicate& predicate) = 0;
+
+    // Index a row appended to the table
+    virtual void insert(int rowId, const Row& row) = 0;
+
+    // Predicted seeks/transfers of evaluate(predicate)
+    virtual CostEstimate estimate(const Predicate& predicate, const StatsCatalog& stats) = 0;
+
+protected:
+    // Equality and range on the key column map onto lookup() and range()
+    vector<int> evaluateOnKey(const Predicate& predicate) {
+        if (predicate.kind == Predicate::Equal && predicate.column == "key") return lookup(predicate.low);
+        if (predicate.kind == Predicate::Range && predicate.column == "key") return range(predicate.low, predicate.high);
+        throw invalid_argument(name() + " cannot evaluate " + predicate.describe());
+    }
+};
+
+// Reads every data block of the table once
+class FullScan : public Index {
+private:
+    const Table& table;
+
+    vector<int> scan(const Predicate& predicate) {
+        vector<int> rows;
+        for (long long block = 0; block < table.blockCount(); block++) {
+            diskAccess(block);
+            long long end = min(table.size(), (block + 1) * table.rowsPerBlock);
+            for (long long rowId = block * table.rowsPerBlock; rowId < end; rowId++) {
+                if (predicate.matches(table.row(rowId))) rows.push_back(rowId);
+            }
+        }
+        return rows;
+    }
+
+public:
+    FullScan(const Table& source) : table(source) {}
+
+    string name() const override { return "full-scan"; }
+
+    vector<int> lookup(int key) override { return scan(Predicate::equal("key", key)); }
+
+    vector<int> range(int low, int high) override { return scan(Predicate::between("key", low, high)); }
+
+    vector<int> evaluate(const Predicate& predicate) override { return scan(predicate); }
+
+    // The row itself is written by whoever appends it; charge its data block
+    void insert(int rowId, const Row&) override {
+        diskAccess(rowId / table.rowsPerBlock, AccessType::Write);
+    }
+
+    CostEstimate estimate(const Predicate&, const StatsCatalog&) override {
+        CostEstimate c;
+        c.seeks = 1;
+        c.transfers = table.blockCount();
+        return c;
+    }
+};
+
+// HashIndex over the key column: equality only
+class HashIndexAccess : public Index {
+private:
+    HashIndex hashIndex;
+
+public:
+    HashIndexAccess(int numBuckets, int capacity) : hashIndex(numBuckets, capacity) {}
+
+    HashIndex& index() { return hashIndex; }
+
+    string name() const override { return "hash"; }
+
+    vector<int> lookup(int key) override { return hashIndex.lookup(key); }
+
+    vector<int> range(int, int) override {
+        throw invalid_argument("hash index cannot answer range queries");
+    }
+
+    vector<int> evaluate(const Predicate& predicate) override { return evaluateOnKey(predicate); }
+
+    void insert(int rowId, const Row& row) override { hashIndex.insert(row.key, rowId); }
+
+    // The whole chain of the key's bucket is read; chains are not contiguous
+    CostEstimate estimate(const Predicate& predicate, const StatsCatalog& stats) override {
+        if (predicate.kind != Predicate::Equal || predicate.column != "key") return CostEstimate::unsupported();
+        double averageChain = (double)hashIndex.blockCount() / hashIndex.bucketCount();
+        double matchBlocks = ceil((double)estimatedRows(predicate, stats) / hashIndex.capacity());
+        CostEstimate c;
+        c.transfers = max(averageChain, matchBlocks);
+        c.seeks = c.transfers;
+        return c;
+    }
+};
+
+// BPlusTree over the key column: equality and ranges through the leaf chain
+class BPlusTreeAccess : public Index {
+private:
+    BPlusTree tree;
+    long long entries = 0;
+
+public:
+    BPlusTreeAccess(int C, int gamma, int eta) : tree(C, gamma, eta) {}
+
+    BPlusTree& index() { return tree; }
+
+    string name() const override { return "btree"; }
+
+    // Duplicates may span leaves, so equality is a one-key range
+    vector<int> lookup(int key) override { return range(key, key); }
+
+    vector<int> range(int low, int high) override {
+        vector<int> rows;
+        tree.searchRange(low, high, rows);
+        return rows;
+    }
+
+    vector<int> evaluate(const Predicate& predicate) override { return evaluateOnKey(predicate); }
+
+    void insert(int rowId, const Row& row) override {
+        tree.insert(row.key, rowId);
+        entries++;
+    }
+
+    // One block per inner level, then as many leaves as the matches fill;
+    // a leaf costs a seek unless it directly follows its predecessor on disk
+    CostEstimate estimate(const Predicate& predicate, const StatsCatalog& stats) override {
+        bool onKey = predicate.column == "key";
+        if (!onKey || (predicate.kind != Predicate::Equal && predicate.kind != Predicate::Range)) {
+            return CostEstimate::unsupported();
+        }
+        pair<int, int> chain = tree.leafChainStats();
+        double perLeaf = max(1.0, (double)entries / chain.first);
+        double contiguity = chain.first > 1 ? (double)chain.second / (chain.first - 1) : 0;
+        double leaves = 1 + estimatedRows(predicate, stats) / perLeaf;
+        int innerLevels = tree.calculateHeight() - 1;
+
+        CostEstimate c;
+        c.transfers = innerLevels + leaves;
+        c.seeks = innerLevels + 1 + (leaves - 1) * (1 - contiguity);
+        return c;
+    }
+};
+
+// BitmapIndex over the low-cardinality columns: equality and AND/OR of two
+// equalities. Bitmap names follow the demo convention "<column>=<value>".
+class BitmapIndexAccess : public Index {
+private:
+    BitmapIndex bitmapIndex;
+    vector<string> columns;
+
+    static string bitmapName(const Predicate& p) {
+        return p.column + "=" + to_string(p.low);
+    }
+
+    bool indexed(const Predicate& p) const {
+        return p.kind == Predicate::Equal && find(columns.begin(), columns.end(), p.column) != columns.end();
+    }
+
+    // Data blocks touched when `matches` random rows are fetched, and the
+    // seeks among them (a hit block right after another hit needs none)
+    void dataBlockCost(double matches, double& blocks, double& seeks) const {
+        double dataBlocks = ceil((double)bitmapIndex.getNumRows() / bitmapIndex.getRowsPerDataBlock());
+        blocks = dataBlocks * (1 - pow(1 - 1 / dataBlocks, matches));
+        seeks = blocks > 0 ? max(1.0, blocks * (1 - blocks / dataBlocks)) : 0;
+    }
+
+public:
+    BitmapIndexAccess(int numRows, int bitsPerBlock, int dataBlocks, int rowsPerBlock,
+                      const vector<string>& indexedColumns)
+        : bitmapIndex(numRows, bitsPerBlock, dataBlocks, rowsPerBlock), columns(indexedColumns) {
+        bitmapIndex.setVerbose(false);
+    }
+
+    BitmapIndex& index() { return bitmapIndex; }
+
+    string name() const override { return "bitmap"; }
+
+    // Set the bits of every indexed column in one scan, then flush each bitmap once
+    void build(const Table& table) {
+        loadDataBlocks(table.size(), table.rowsPerBlock);
+        vector<string> names;
+        for (long long rowId = 0; rowId < table.size() && rowId < bitmapIndex.getNumRows(); rowId++) {
+            Row row = table.row(rowId);
+            for (const string& column : columns) {
+                string bitmap = column + "=" + to_string(columnValue(row, column));
+                if (!bitmapIndex.hasBitmap(bitmap)) names.push_back(bitmap);
+                bitmapIndex.setBitBuffered(bitmap, rowId, true);
+            }
+        }
+        for (const string& bitmap : names) bitmapIndex.flushBitmapToDisk(bitmap);
+    }
+
+    vector<int> lookup(int) override {
+        throw invalid_argument("bitmap index does not cover the key column");
+    }
+
+    vector<int> range(int, int) override {
+        throw invalid_argument("bitmap index does not cover the key column");
+    }
+
+    vector<int> evaluate(const Predicate& predicate) override {
+        vector<bool> bits;
+        if (indexed(predicate)) {
+            if (!bitmapIndex.hasBitmap(bitmapName(predicate))) return {};
+            bits = bitmapIndex.equalityQuery(bitmapName(predicate));
+        } else if ((predicate.kind == Predicate::And || predicate.kind == Predicate::Or)
+                   && indexed(predicate.terms[0]) && indexed(predicate.terms[1])) {
+            // A value without a bitmap matches no rows; the index is never changed
+            string left = bitmapName(predicate.terms[0]);
+            string right = bitmapName(predicate.terms[1]);
+            bool haveLeft = bitmapIndex.hasBitmap(left);
+            bool haveRight = bitmapIndex.hasBitmap(right);
+            if (predicate.kind == Predicate::And) {
+                if (!haveLeft || !haveRight) return {};
+                bits = bitmapIndex.bitmapAND(left, right);
+            } else if (haveLeft && haveRight) {
+                bits = bitmapIndex.bitmapOR(left, right);
+            } else if (haveLeft || haveRight) {
+                bits = bitmapIndex.equalityQuery(haveLeft ? left : right);
+            } else {
+                return {};
+            }
+        } else {
+            throw invalid_argument("bitmap index cannot evaluate " + predicate.describe());
+        }
+        return bitmapIndex.getMatchingRows(bits);
+    }
+
+    void insert(int rowId, const Row& row) override {
+        if (rowId >= bitmapIndex.getNumRows()) {
+            throw out_of_range("bitmap index was sized for " + to_string(bitmapIndex.getNumRows()) + " rows");
+        }
+        for (const string& column : columns) {
+            bitmapIndex.setBit(column + "=" + to_string(columnValue(row, column)), rowId, true);
+        }
+    }
+
+    // Equality reads one bitmap and each matching data block once; AND/OR read
+    // two bitmaps and then one data block per matching row
+    CostEstimate estimate(const Predicate& predicate, const StatsCatalog& stats) override {
+        double matches = estimatedRows(predicate, stats);
+        double blocks, dataSeeks;
+        dataBlockCost(matches, blocks, dataSeeks);
+
+        CostEstimate c;
+        if (indexed(predicate)) {
+            c.transfers = bitmapIndex.getBlocksPerBitmap() + blocks;
+            c.seeks = 1 + dataSeeks;
+        } else if ((predicate.kind == Predicate::And || predicate.kind == Predicate::Or)
+                   && indexed(predicate.terms[0]) && indexed(predicate.terms[1])) {
+            c.transfers = 2 * bitmapIndex.getBlocksPerBitmap() + matches;
+            c.seeks = 2 + dataSeeks;
+        } else {
+            return CostEstimate::unsupported();
+        }
+        return c;
+    }
+};
+
+#endif
@@ -0,0 +1,87 @@
+#include <cstdio>
+#include <random>
+
+#include "ingest.h"
+#include "workload.h"
+
+// Build all three indexes from one row file in a single pass. The bitmaps
+// need the row count up front: column files store it, for CSV it comes from
+// `expectedRows` or, failing that, from a counting pass that is timed too.
+IngestReport ingestFile(const string& path, long long chunkRows, size_t queueDepth, long long expectedRows = -1) {
+    bool binary = path.size() < 4 || path.substr(path.size() - 4) != ".csv";
+    double countSeconds = 0;
+    if (!binary && expectedRows < 0) {
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        expectedRows = ChunkReader::countRows(path);
+        countSeconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    }
+    ChunkReader reader(path, binary, expectedRows);
+    long long rows = reader.totalRows();
+
+    int capacity = BlockGeometry::keysPerBlock;
+    HashIndex hash(max(1LL, rows / (capacity * 3 / 4)), capacity);
+    BPlusTree tree(BlockGeometry::blockBytes, BlockGeometry::keyBytes, BlockGeometry::pointerBytes);
+    int rowsPerBlock = BlockGeometry::rowsPerBlock;
+    BitmapIndex bitmap(rows, BlockGeometry::bitsPerBlock, (rows + rowsPerBlock - 1) / rowsPerBlock, rowsPerBlock);
+    bitmap.setVerbose(false);
+
+    IngestPipeline pipeline(chunkRows, queueDepth);
+    pipeline.addHashIndex(hash);
+    pipeline.addBPlusTree(tree);
+    pipeline.addBitmapIndex(bitmap, {"a", "b"});
+    IngestReport report = pipeline.run(reader);
+    report.countSeconds = countSeconds;
+    report.seconds += countSeconds;
+    return report;
+}
+
+int main(int argc, char* argv[]) {
+    long long chunkRows = 4096;
+    long long queueDepth = 4;
+    long long expectedRows = -1;
+    string path;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            string arg = argv[i];
+            if (arg == "--chunk" && i + 1 < argc) chunkRows = stoll(argv[++i]);
+            else if (arg == "--rows" && i + 1 < argc) expectedRows = stoll(argv[++i]);
+            else if (arg == "--queue" && i + 1 < argc) queueDepth = stoll(argv[++i]);
+            else path = arg;
+        }
+        if (chunkRows < 1) throw invalid_argument("--chunk must be at least 1");
+        if (queueDepth < 1) throw invalid_argument("--queue must be at least 1");
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+
+    try {
+        if (!path.empty()) {
+            cout << "==== Ingesting " << path << " ====" << endl;
+            ingestFile(path, chunkRows, queueDepth, expectedRows).print();
+            return 0;
+        }
+
+        // No input given: generate a table and ingest it in both file formats
+        long long rows = 200000;
+        mt19937_64 rng(5);
+        KeyGenerator gen(KeyDistribution::Uniform, rows);
+        Table table = generateTable(gen, rows, 16, 4, rng);
+
+        writeCSV("ingest_demo.csv", table);
+        writeColumnFile("ingest_demo.col", table);
+
+        cout << "==== Ingesting ingest_demo.csv ====" << endl;
+        ingestFile("ingest_demo.csv", chunkRows, queueDepth, rows).print();
+        cout << "\n==== Ingesting ingest_demo.col ====" << endl;
+        ingestFile("ingest_demo.col", chunkRows, queueDepth).print();
+
+        remove("ingest_demo.csv");
+        remove("ingest_demo.col");
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,357 @@
+#ifndef INGEST_H
+#define INGEST_H
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <set>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+#include <stdexcept>
+#include <cstdint>
+#include <cctype>
+
+#include "diskModel.h"
+#include "table.h"
+#include "hashIndex.h"
+#include "btreeIndex.h"
+#include "bitmapIndex.h"
+
+using namespace std;
+
+// Streaming ingest: one reader turns a row file into fixed-size chunks and
+// hands every chunk to each configured index. Each index consumes its chunks
+// on its own thread from a bounded queue, so a slow index makes the reader
+// wait instead of letting chunks pile up in memory.
+
+// Rows [firstRowId, firstRowId + size()) stored column-wise
+struct RowChunk {
+    long long firstRowId = 0;
+    vector<int> keys;
+    vector<int> columnA;
+    vector<int> columnB;
+
+    long long size() const {
+        return keys.size();
+    }
+};
+
+// Reads "key,a,b" CSV lines (an optional header line is skipped) or a binary
+// column file: int64 row count, then all keys, all a values, all b values as
+// int32. A CSV file is read in a single pass, so its row count is only known
+// up front when the caller supplies it; countRows() is a separate pre-pass
+// that applies the same line rules as next().
+class ChunkReader {
+private:
+    bool binary;
+    ifstream file;
+    long long rows = -1;        // expected rows, -1 while unknown
+    long long nextRow = 0;
+    long long lineNumber = 0;
+
+    // A data line starts with a digit or a minus sign; only the first line
+    // may be something else (the header). Empty lines are ignored.
+    static bool isDataLine(const string& line, long long lineNumber) {
+        if (line.empty()) return false;
+        if (isdigit((unsigned char)line[0]) || line[0] == '-') return true;
+        if (lineNumber == 1) return false;
+        throw runtime_error("malformed row: " + line);
+    }
+
+    void readColumn(vector<int>& column, int columnIdx, long long first, long long count) {
+        column.resize(count);
+        file.seekg(sizeof(int64_t) + (columnIdx * rows + first) * sizeof(int32_t));
+        file.read((char*)column.data(), count * sizeof(int32_t));
+        if (!file) throw runtime_error("truncated column file");
+    }
+
+public:
+    // `expectedRows` sizes a CSV input without a counting pass; reading more
+    // rows than that fails. Column files carry their own count.
+    ChunkReader(const string& path, bool binaryFormat, long long expectedRows = -1) : binary(binaryFormat) {
+        file.open(path, binary ? ios::binary : ios::in);
+        if (!file) throw runtime_error("cannot open " + path);
+
+        if (binary) {
+            int64_t count = 0;
+            file.read((char*)&count, sizeof(count));
+            if (!file || count < 0) throw runtime_error(path + " is not a column file");
+            rows = count;
+        } else {
+            rows = expectedRows;
+        }
+    }
+
+    // Data rows of a CSV file, one full read of it
+    static long long countRows(const string& path) {
+        ifstream in(path);
+        if (!in) throw runtime_error("cannot open " + path);
+        string line;
+        long long count = 0, number = 0;
+        while (getline(in, line)) {
+            if (isDataLine(line, ++number)) count++;
+        }
+        return count;
+    }
+
+    // Rows known before reading: the column file header or the caller's
+    // expected count for CSV, otherwise -1
+    long long totalRows() const {
+        return rows;
+    }
+
+    // Fill `chunk` with up to maxRows rows; false once the file is exhausted
+    bool next(RowChunk& chunk, long long maxRows) {
+        chunk.firstRowId = nextRow;
+        chunk.keys.clear();
+        chunk.columnA.clear();
+        chunk.columnB.clear();
+
+        if (binary) {
+            if (nextRow >= rows) return false;
+            long long count = min(maxRows, rows - nextRow);
+            readColumn(chunk.keys, 0, nextRow, count);
+            readColumn(chunk.columnA, 1, nextRow, count);
+            readColumn(chunk.columnB, 2, nextRow, count);
+        } else {
+            string line;
+            while (chunk.size() < maxRows && getline(file, line)) {
+                if (!isDataLine(line, ++lineNumber)) continue;
+                if (rows >= 0 && nextRow + chunk.size() >= rows) {
+                    throw runtime_error("input has more than the expected " + to_string(rows) + " rows");
+                }
+                int key, a, b;
+                char comma1, comma2;
+                istringstream fields(line);
+                // Exactly three comma-separated ints; only whitespace (or a '\r') may follow
+                if (!(fields >> key >> comma1 >> a >> comma2 >> b) || comma1 != ',' || comma2 != ','
+                    || !(fields >> ws).eof()) {
+                    throw runtime_error("malformed row: " + line);
+                }
+                chunk.keys.push_back(key);
+                chunk.columnA.push_back(a);
+                chunk.columnB.push_back(b);
+            }
+        }
+        nextRow += chunk.size();
+        return chunk.size() > 0;
+    }
+};
+
+inline void writeCSV(const string& path, const Table& table) {
+    ofstream out(path);
+    out << "key,a,b\n";
+    for (long long i = 0; i < table.size(); i++) {
+        out << table.keys[i] << "," << table.columnA[i] << "," << table.columnB[i] << "\n";
+    }
+}
+
+inline void writeColumnFile(const string& path, const Table& table) {
+    ofstream out(path, ios::binary);
+    int64_t count = table.size();
+    out.write((const char*)&count, sizeof(count));
+    for (const vector<int>* column : {&table.keys, &table.columnA, &table.columnB}) {
+        out.write((const char*)column->data(), column->size() * sizeof(int32_t));
+    }
+}
+
+// Fixed-capacity queue; push() blocks while full, pop() fails once the queue
+// is closed and drained
+template <typename T>
+class BoundedQueue {
+private:
+    vector<T> items;
+    size_t head = 0;
+    size_t count = 0;
+    bool closed = false;
+    mutex lock;
+    condition_variable notFull;
+    condition_variable notEmpty;
+
+public:
+    BoundedQueue(size_t capacity) : items(capacity) {
+        if (capacity < 1) throw invalid_argument("queue capacity must be at least 1");
+    }
+
+    void push(T item) {
+        unique_lock<mutex> guard(lock);
+        notFull.wait(guard, [&] { return count < items.size(); });
+        items[(head + count) % items.size()] = move(item);
+        count++;
+        notEmpty.notify_one();
+    }
+
+    bool pop(T& item) {
+        unique_lock<mutex> guard(lock);
+        notEmpty.wait(guard, [&] { return count > 0 || closed; });
+        if (count == 0) return false;
+        item = move(items[head]);
+        head = (head + 1) % items.size();
+        count--;
+        notFull.notify_one();
+        return true;
+    }
+
+    void close() {
+        lock_guard<mutex> guard(lock);
+        closed = true;
+        notEmpty.notify_all();
+    }
+};
+
+struct SinkReport {
+    string name;
+    long long rows = 0;
+    double busySeconds = 0;     // time spent inside the index, excluding waits
+    IOStats io;
+    string error;
+};
+
+struct IngestReport {
+    long long rows = 0;
+    long long chunks = 0;
+    double seconds = 0;
+    double countSeconds = 0;    // CSV counting pass, if one ran; included in seconds
+    vector<SinkReport> sinks;
+
+    double rowsPerSecond() const {
+        return seconds > 0 ? rows / seconds : 0;
+    }
+
+    void print() const {
+        cout << "Ingested " << rows << " rows in " << chunks << " chunks, " << seconds << " s ("
+             << (long long)rowsPerSecond() << " rows/s";
+        if (countSeconds > 0) cout << ", including a " << countSeconds << " s counting pass";
+        cout << ")" << endl;
+        for (const SinkReport& s : sinks) {
+            cout << "  " << s.name << ": " << s.rows << " rows, busy " << s.busySeconds << " s, "
+                 << s.io.seeks() << " seeks, " << s.io.transfers() << " transfers ("
+                 << s.io.readTransfers << " reads, " << s.io.writeTransfers << " writes)";
+            if (!s.error.empty()) cout << ", failed: " << s.error;
+            cout << endl;
+        }
+    }
+};
+
+class IngestPipeline {
+private:
+    typedef shared_ptr<const RowChunk> ChunkPtr;
+
+    struct Sink {
+        string name;
+        function<void(const RowChunk&)> consume;
+        function<void()> finish;
+    };
+
+    long long chunkRows;
+    size_t queueDepth;
+    vector<Sink> sinks;
+
+    // Worker loop of one index; its thread-local disk counters are its I/O
+    static void drain(Sink& sink, BoundedQueue<ChunkPtr>& queue, SinkReport& report) {
+        using Clock = chrono::steady_clock;
+        DiskModel::reset();
+        report.name = sink.name;
+
+        ChunkPtr chunk;
+        while (queue.pop(chunk)) {
+            if (!report.error.empty()) continue;    // keep draining so the reader never blocks
+            Clock::time_point t0 = Clock::now();
+            try {
+                sink.consume(*chunk);
+                report.rows += chunk->size();
+            } catch (const exception& e) {
+                report.error = e.what();
+            }
+            report.busySeconds += chrono::duration<double>(Clock::now() - t0).count();
+        }
+
+        if (report.error.empty()) {
+            Clock::time_point t0 = Clock::now();
+            if (sink.finish) sink.finish();
+            report.busySeconds += chrono::duration<double>(Clock::now() - t0).count();
+        }
+        report.io = DiskModel::stats();
+    }
+
+public:
+    // Memory stays bounded by roughly (depth + 2) chunks of `chunk` rows
+    IngestPipeline(long long chunk = 4096, size_t depth = 4) : chunkRows(chunk), queueDepth(depth) {
+        if (chunkRows < 1) throw invalid_argument("chunk size must be at least 1 row");
+        if (queueDepth < 1) throw invalid_argument("queue depth must be at least 1");
+    }
+
+    void addHashIndex(HashIndex& index) {
+        sinks.push_back({"hash", [&index](const RowChunk& c) {
+            for (long long i = 0; i < c.size(); i++) index.insert(c.keys[i], c.firstRowId + i);
+        }, nullptr});
+    }
+
+    void addBPlusTree(BPlusTree& index) {
+        sinks.push_back({"btree", [&index](const RowChunk& c) {
+            for (long long i = 0; i < c.size(); i++) index.insert(c.keys[i], c.firstRowId + i);
+        }, nullptr});
+    }
+
+    // Sets the bits of every listed column ("a", "b") as rows stream past and
+    // flushes each touched bitmap once at the end
+    void addBitmapIndex(BitmapIndex& index, const vector<string>& columns) {
+        shared_ptr<set<string>> touched = make_shared<set<string>>();
+        sinks.push_back({"bitmap", [&index, columns, touched](const RowChunk& c) {
+            for (long long i = 0; i < c.size(); i++) {
+                long long rowId = c.firstRowId + i;
+                if (rowId >= index.getNumRows()) {
+                    throw out_of_range("bitmap index was sized for " + to_string(index.getNumRows()) + " rows");
+                }
+                Row row = {c.keys[i], c.columnA[i], c.columnB[i]};
+                for (const string& column : columns) {
+                    string bitmap = column + "=" + to_string(columnValue(row, column));
+                    if (touched->insert(bitmap).second && !index.hasBitmap(bitmap)) index.createBitmap(bitmap);
+                    index.setBitBuffered(bitmap, rowId, true);
+                }
+            }
+        }, [&index, touched]() {
+            for (const string& bitmap : *touched) index.flushBitmapToDisk(bitmap);
+        }});
+    }
+
+    IngestReport run(ChunkReader& reader) {
+        using Clock = chrono::steady_clock;
+        IngestReport report;
+        report.sinks.resize(sinks.size());
+
+        vector<unique_ptr<BoundedQueue<ChunkPtr>>> queues;
+        vector<thread> workers;
+        for (size_t s = 0; s < sinks.size(); s++) {
+            queues.emplace_back(new BoundedQueue<ChunkPtr>(queueDepth));
+            workers.emplace_back(drain, ref(sinks[s]), ref(*queues[s]), ref(report.sinks[s]));
+        }
+
+        Clock::time_point begin = Clock::now();
+        try {
+            while (true) {
+                shared_ptr<RowChunk> chunk = make_shared<RowChunk>();
+                if (!reader.next(*chunk, chunkRows)) break;
+                report.rows += chunk->size();
+                report.chunks++;
+                for (auto& queue : queues) queue->push(chunk);
+            }
+        } catch (...) {
+            for (auto& queue : queues) queue->close();
+            for (thread& worker : workers) worker.join();
+            throw;
+        }
+        for (auto& queue : queues) queue->close();
+        for (thread& worker : workers) worker.join();
+        report.seconds = chrono::duration<double>(Clock::now() - begin).count();
+        return report;
+    }
+};
+
+#endif
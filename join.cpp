@@ -0,0 +1,89 @@
+#include <random>
+
+#include "join.h"
+#include "workload.h"
+
+void printJoin(const string& name, const JoinResult& r) {
+    cout << name << ": " << r.outputRows() << " rows, "
+         << r.io.seeks() << " seeks, " << r.io.transfers() << " transfers, "
+         << r.seeksPerRow() << " seeks/row, " << r.transfersPerRow() << " transfers/row" << endl;
+}
+
+int main() {
+    // Inner table with indexes on its key and on column "a"
+    long long innerRows = 100000;
+    mt19937_64 rng(11);
+    KeyGenerator gen(KeyDistribution::Uniform, innerRows);
+    Table inner = generateTable(gen, innerRows, 16, 4, rng);
+
+    int capacity = BlockGeometry::keysPerBlock;
+    HashIndex hash(innerRows / (capacity * 3 / 4), capacity);
+    BPlusTree tree(BlockGeometry::blockBytes, BlockGeometry::keyBytes, BlockGeometry::pointerBytes);
+    BitmapIndex bitmap(innerRows, BlockGeometry::bitsPerBlock, inner.blockCount(), inner.rowsPerBlock);
+    bitmap.setVerbose(false);
+    for (long long rowId = 0; rowId < innerRows; rowId++) {
+        hash.insert(inner.keys[rowId], rowId);
+        tree.insert(inner.keys[rowId], rowId);
+        bitmap.setBitBuffered("a=" + to_string(inner.columnA[rowId]), rowId, true);
+    }
+    for (int v = 0; v < 16; v++) bitmap.flushBitmapToDisk("a=" + to_string(v));
+
+    // Outer table: half of its keys hit the inner table, half are random
+    Table outer;
+    for (int i = 0; i < 20000; i++) {
+        int key = i % 2 ? inner.keys[rng() % innerRows] : gen.next(rng);
+        outer.append({key, (int)(rng() % 3), 0});
+    }
+
+    cout << "==== Joining " << outer.size() << " outer rows with " << innerRows << " inner rows ====" << endl;
+
+    // Baseline: one unsorted probe per outer row
+    DiskModel::reset();
+    JoinResult naive;
+    for (long long rowId = 0; rowId < outer.size(); rowId++) {
+        for (int innerRow : hash.lookup(outer.keys[rowId])) {
+            naive.outerRows.push_back(rowId);
+            naive.innerRows.push_back(innerRow);
+        }
+    }
+    naive.io = DiskModel::stats();
+    printJoin("Row-at-a-time hash probe  ", naive);
+
+    // Same for the B+ tree: every probe descends from the root
+    DiskModel::reset();
+    JoinResult naiveTree;
+    vector<pair<int, int>> probeMatches;
+    for (long long rowId = 0; rowId < outer.size(); rowId++) {
+        probeMatches.clear();
+        tree.searchBatch({outer.keys[rowId]}, probeMatches);
+        for (auto& match : probeMatches) {
+            naiveTree.outerRows.push_back(rowId);
+            naiveTree.innerRows.push_back(match.second);
+        }
+    }
+    naiveTree.io = DiskModel::stats();
+    printJoin("Row-at-a-time B+tree probe", naiveTree);
+
+    DiskModel::reset();
+    printJoin("Index nested loop (hash)  ", IndexNestedLoopJoin(hash).run(outer, "key"));
+
+    DiskModel::reset();
+    printJoin("Index nested loop (B+tree)", IndexNestedLoopJoin(tree).run(outer, "key"));
+
+    // Merge join streams its outer input in key order, so give it the outer
+    // rows sorted on the key (row ids then refer to the sorted copy)
+    vector<int> order(outer.size());
+    for (long long rowId = 0; rowId < outer.size(); rowId++) order[rowId] = rowId;
+    stable_sort(order.begin(), order.end(), [&](int x, int y) { return outer.keys[x] < outer.keys[y]; });
+    Table sortedOuter;
+    for (int rowId : order) sortedOuter.append(outer.row(rowId));
+
+    DiskModel::reset();
+    printJoin("Merge join (B+tree leaves)", MergeJoin(tree).run(sortedOuter, "key"));
+
+    // Outer column "a" only takes the values 0..2, a low-cardinality join key
+    DiskModel::reset();
+    printJoin("Bitmap semi-join on a     ", BitmapSemiJoin(bitmap, "a").run(outer, "a"));
+
+    return 0;
+}
@@ -0,0 +1,220 @@
+#ifndef JOIN_H
+#define JOIN_H
+
+#include <vector>
+#include <string>
+#include <set>
+#include <algorithm>
+#include <stdexcept>
+
+#include "diskModel.h"
+#include "table.h"
+#include "hashIndex.h"
+#include "btreeIndex.h"
+#include "bitmapIndex.h"
+
+using namespace std;
+
+// Join operators that use the indexes of the inner table. The outer table is
+// consumed in chunks of `chunkSize` rows and every chunk is probed as one
+// batch; results are kept column-wise (outer rows, inner rows).
+
+struct JoinResult {
+    vector<int> outerRows;    // empty for semi-joins
+    vector<int> innerRows;
+    IOStats io;
+
+    long long outputRows() const {
+        return innerRows.size();
+    }
+
+    double seeksPerRow() const {
+        return outputRows() ? (double)io.seeks() / outputRows() : 0;
+    }
+
+    double transfersPerRow() const {
+        return outputRows() ? (double)io.transfers() / outputRows() : 0;
+    }
+};
+
+// Probes a HashIndex or a BPlusTree on the inner key with each outer chunk.
+// B+ tree probes are sorted so consecutive keys reuse the current leaf; hash
+// probes are ordered by bucket inside HashIndex::lookupBatch.
+class IndexNestedLoopJoin {
+private:
+    HashIndex* hashIndex = nullptr;
+    BPlusTree* tree = nullptr;
+    int chunkSize;
+
+public:
+    IndexNestedLoopJoin(HashIndex& inner, int chunk = 1024) : hashIndex(&inner), chunkSize(chunk) {}
+
+    IndexNestedLoopJoin(BPlusTree& inner, int chunk = 1024) : tree(&inner), chunkSize(chunk) {}
+
+    JoinResult run(const Table& outer, const string& outerColumn) {
+        JoinResult result;
+        const vector<int>& column = outer.column(outerColumn);
+        IOScope query;
+
+        vector<int> rows, keys;
+        vector<pair<int, int>> matches;
+        for (long long start = 0; start < outer.size(); start += chunkSize) {
+            long long end = min(outer.size(), start + chunkSize);
+
+            rows.clear();
+            for (long long rowId = start; rowId < end; rowId++) rows.push_back(rowId);
+            if (tree) {
+                sort(rows.begin(), rows.end(), [&](int x, int y) { return column[x] < column[y]; });
+            }
+            keys.clear();
+            for (int rowId : rows) keys.push_back(column[rowId]);
+
+            matches.clear();
+            if (tree) tree->searchBatch(keys, matches);
+            else hashIndex->lookupBatch(keys, matches);
+
+            for (auto& match : matches) {
+                result.outerRows.push_back(rows[match.first]);
+                result.innerRows.push_back(match.second);
+            }
+        }
+
+        result.io = query.stats();
+        return result;
+    }
+};
+
+// Walks the B+ tree leaf chain beside an outer input that is already sorted
+// on the join column (e.g. produced by an index scan or an external sort).
+// The outer table is consumed one chunk at a time and the inner cursor and
+// the current run of equal keys carry over between chunks, so memory stays
+// O(chunkSize) plus the longest inner run. Unsorted input is rejected.
+class MergeJoin {
+private:
+    BPlusTree& tree;
+    int chunkSize;
+
+    // Inner cursor, kept across chunks
+    BPlusNode* leaf = nullptr;
+    size_t pos = 0;
+    bool started = false;
+    bool haveRun = false;
+    int runKey = 0;
+    vector<int> runValues;     // inner values matching runKey
+
+    // Advance the inner cursor to `key` and collect its run of inner values
+    void seek(int key) {
+        if (!started) {
+            leaf = tree.findLeaf(key);
+            diskAccess(leaf->blockID);
+            pos = 0;
+            started = true;
+        }
+
+        // Advance the inner cursor to the first entry >= key
+        runValues.clear();
+        while (leaf) {
+            while (pos < leaf->keyValuePairs.size() && leaf->keyValuePairs[pos].first < key) pos++;
+            if (pos < leaf->keyValuePairs.size()) break;
+            leaf = leaf->next;
+            pos = 0;
+            if (leaf) diskAccess(leaf->blockID);
+        }
+        // Collect the run of equal inner keys, possibly across leaves
+        while (leaf && pos < leaf->keyValuePairs.size() && leaf->keyValuePairs[pos].first == key) {
+            runValues.push_back(leaf->keyValuePairs[pos].second);
+            pos++;
+            if (pos == leaf->keyValuePairs.size() && leaf->next) {
+                leaf = leaf->next;
+                pos = 0;
+                diskAccess(leaf->blockID);
+            }
+        }
+        runKey = key;
+        haveRun = true;
+    }
+
+public:
+    MergeJoin(BPlusTree& inner, int chunk = 1024) : tree(inner), chunkSize(chunk) {}
+
+    // Forget the inner cursor before joining a new outer stream
+    void reset() {
+        leaf = nullptr;
+        pos = 0;
+        started = false;
+        haveRun = false;
+        runValues.clear();
+    }
+
+    // Join the next chunk of the outer stream. `keys` must continue the key
+    // order of the earlier chunks; `rowIds` are reported as the outer rows.
+    void joinChunk(const vector<int>& keys, const vector<int>& rowIds, JoinResult& result) {
+        for (size_t i = 0; i < keys.size(); i++) {
+            int key = keys[i];
+            if (haveRun && key < runKey) {
+                throw invalid_argument("merge join needs outer input sorted on the join column");
+            }
+            if (!haveRun || key != runKey) seek(key);
+
+            for (int value : runValues) {
+                result.outerRows.push_back(rowIds[i]);
+                result.innerRows.push_back(value);
+            }
+        }
+    }
+
+    // Join an outer table stored in join-column order
+    JoinResult run(const Table& outer, const string& outerColumn) {
+        JoinResult result;
+        const vector<int>& column = outer.column(outerColumn);
+        reset();
+        IOScope query;
+
+        vector<int> keys, rows;
+        for (long long start = 0; start < outer.size(); start += chunkSize) {
+            long long end = min(outer.size(), start + chunkSize);
+            keys.assign(column.begin() + start, column.begin() + end);
+            rows.clear();
+            for (long long rowId = start; rowId < end; rowId++) rows.push_back(rowId);
+            joinChunk(keys, rows, result);
+        }
+
+        result.io = query.stats();
+        return result;
+    }
+};
+
+// Semi-join for low-cardinality join keys: collects the distinct outer values
+// chunk by chunk, then ORs the inner bitmaps "<innerColumn>=<value>" once.
+// Returns the inner rows that have at least one partner.
+class BitmapSemiJoin {
+private:
+    BitmapIndex& bitmapIndex;
+    string innerColumn;
+    int chunkSize;
+
+public:
+    BitmapSemiJoin(BitmapIndex& inner, const string& column, int chunk = 1024)
+        : bitmapIndex(inner), innerColumn(column), chunkSize(chunk) {}
+
+    JoinResult run(const Table& outer, const string& outerColumn) {
+        JoinResult result;
+        const vector<int>& column = outer.column(outerColumn);
+        IOScope query;
+
+        set<int> values;
+        for (long long start = 0; start < outer.size(); start += chunkSize) {
+            long long end = min(outer.size(), start + chunkSize);
+            values.insert(column.begin() + start, column.begin() + end);
+        }
+
+        vector<string> names;
+        for (int v : values) names.push_back(innerColumn + "=" + to_string(v));
+        result.innerRows = bitmapIndex.getMatchingRows(bitmapIndex.bitmapUnion(names));
+
+        result.io = query.stats();
+        return result;
+    }
+};
+
+#endif
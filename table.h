@@ -0,0 +1,62 @@
+#ifndef TABLE_H
+#define TABLE_H
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+
+#include "diskModel.h"
+
+using namespace std;
+
+// The relation the indexes are built over: an integer key column plus two
+// low-cardinality attribute columns "a" and "b" (the kind of columns bitmap
+// indexes are meant for). Rows are stored in row-id order, rowsPerBlock to a
+// data block.
+
+struct Row {
+    int key;
+    int a;
+    int b;
+};
+
+struct Table {
+    vector<int> keys;
+    vector<int> columnA;
+    vector<int> columnB;
+    int rowsPerBlock = BlockGeometry::rowsPerBlock;
+
+    long long size() const {
+        return keys.size();
+    }
+
+    long long blockCount() const {
+        return (size() + rowsPerBlock - 1) / rowsPerBlock;
+    }
+
+    Row row(long long rowId) const {
+        return {keys[rowId], columnA[rowId], columnB[rowId]};
+    }
+
+    void append(const Row& row) {
+        keys.push_back(row.key);
+        columnA.push_back(row.a);
+        columnB.push_back(row.b);
+    }
+
+    const vector<int>& column(const string& name) const {
+        if (name == "key") return keys;
+        if (name == "a") return columnA;
+        if (name == "b") return columnB;
+        throw invalid_argument("unknown column: " + name);
+    }
+};
+
+inline int columnValue(const Row& row, const string& column) {
+    if (column == "key") return row.key;
+    if (column == "a") return row.a;
+    if (column == "b") return row.b;
+    throw invalid_argument("unknown column: " + column);
+}
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <vector>
+#include <string>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <climits>
+#include <stdexcept>
+
+#include "table.h"
+
+using namespace std;
+
+// Seeded key generators shared by the benchmark and the demos. Keys are
+// non-negative ints drawn from a domain of `domainFactor * rows` values
+// (4 by default) so that uniform and Zipfian data contain both duplicates
+// and gaps.
+//
+// Zipfian skew defaults to theta = 0.5: the hottest key then repeats about
+// sqrt(rows) / 4 times, so duplicate chains stay short up to 10^8 rows. The
+// YCSB value 0.99 gives it about rows / 20 copies; hash inserts then walk
+// a chain that grows with the table, and the build becomes quadratic.
+constexpr double DEFAULT_ZIPF_THETA = 0.5;
+constexpr double DEFAULT_KEY_DOMAIN_FACTOR = 4;
+
+enum class KeyDistribution { Uniform, Zipfian, Sequential, Clustered };
+
+inline string distributionName(KeyDistribution dist) {
+    switch (dist) {
+        case KeyDistribution::Uniform: return "uniform";
+        case KeyDistribution::Zipfian: return "zipfian";
+        case KeyDistribution::Sequential: return "sequential";
+        case KeyDistribution::Clustered: return "clustered";
+    }
+    return "unknown";
+}
+
+inline KeyDistribution parseDistribution(const string& name) {
+    if (name == "uniform") return KeyDistribution::Uniform;
+    if (name == "zipfian") return KeyDistribution::Zipfian;
+    if (name == "sequential") return KeyDistribution::Sequential;
+    if (name == "clustered") return KeyDistribution::Clustered;
+    throw invalid_argument("unknown key distribution: " + name);
+}
+
+// Zipfian ranks in [0, items) using the Gray et al. method from YCSB:
+// O(items) setup for zeta(n), then O(1) per sample. Rank 0 is the hottest.
+// The method needs 0 < theta < 1.
+class ZipfianGenerator {
+private:
+    long long items;
+    double theta;
+    double alpha;
+    double zetan;
+    double eta;
+
+    static double zeta(long long n, double theta) {
+        double sum = 0;
+        for (long long i = 1; i <= n; i++) sum += 1.0 / pow((double)i, theta);
+        return sum;
+    }
+
+public:
+    ZipfianGenerator(long long n, double skew = DEFAULT_ZIPF_THETA) : items(n), theta(skew) {
+        if (!(theta > 0 && theta < 1)) throw invalid_argument("Zipfian theta must be in (0, 1)");
+        double zeta2 = zeta(2, theta);
+        zetan = zeta(items, theta);
+        alpha = 1.0 / (1.0 - theta);
+        eta = (1 - pow(2.0 / items, 1 - theta)) / (1 - zeta2 / zetan);
+    }
+
+    long long next(mt19937_64& rng) {
+        double u = uniform_real_distribution<double>(0.0, 1.0)(rng);
+        double uz = u * zetan;
+        if (uz < 1.0) return 0;
+        if (uz < 1.0 + pow(0.5, theta)) return 1;
+        long long rank = (long long)(items * pow(eta * u - eta + 1, alpha));
+        return rank < items ? rank : items - 1;
+    }
+};
+
+class KeyGenerator {
+private:
+    KeyDistribution dist;
+    long long domain;
+    int clusterSize;
+    long long emitted = 0;
+    long long clusterStart = 0;
+    ZipfianGenerator* zipf = nullptr;
+
+public:
+    KeyGenerator(KeyDistribution distribution, long long rows, double zipfTheta = DEFAULT_ZIPF_THETA,
+                 double domainFactor = DEFAULT_KEY_DOMAIN_FACTOR, int clusterRun = 64)
+        : dist(distribution), clusterSize(clusterRun) {
+        if (domainFactor < 1) throw invalid_argument("key domain factor must be at least 1");
+        double size = ceil(domainFactor * max(rows, 1LL));
+        if (size > INT_MAX) throw invalid_argument("key domain exceeds the int key range");
+        domain = (long long)size;
+        if (dist == KeyDistribution::Zipfian) zipf = new ZipfianGenerator(domain, zipfTheta);
+    }
+
+    ~KeyGenerator() {
+        delete zipf;
+    }
+
+    KeyGenerator(const KeyGenerator&) = delete;
+    KeyGenerator& operator=(const KeyGenerator&) = delete;
+
+    long long keyDomain() const {
+        return domain;
+    }
+
+    // Next key of the stream. Sequential keeps counting past the table,
+    // clustered emits runs of consecutive keys at random starting points.
+    int next(mt19937_64& rng) {
+        long long key = 0;
+        switch (dist) {
+            case KeyDistribution::Uniform:
+                key = uniform_int_distribution<long long>(0, domain - 1)(rng);
+                break;
+            case KeyDistribution::Zipfian:
+                key = zipf->next(rng);
+                break;
+            case KeyDistribution::Sequential:
+                key = emitted;
+                break;
+            case KeyDistribution::Clustered:
+                if (emitted % clusterSize == 0) {
+                    clusterStart = uniform_int_distribution<long long>(0, domain - clusterSize)(rng);
+                }
+                key = clusterStart + emitted % clusterSize;
+                break;
+        }
+        emitted++;
+        return (int)key;
+    }
+};
+
+// Generate a table whose key column follows `gen`; column "a" depends on the
+// key and column "b" on the row, so predicates over both are not redundant.
+inline Table generateTable(KeyGenerator& gen, long long rows, int cardinalityA, int cardinalityB,
+                           mt19937_64& rng) {
+    Table table;
+    table.keys.reserve(rows);
+    table.columnA.reserve(rows);
+    table.columnB.reserve(rows);
+    for (long long i = 0; i < rows; i++) {
+        int key = gen.next(rng);
+        table.keys.push_back(key);
+        table.columnA.push_back(key % cardinalityA);
+        table.columnB.push_back((int)(rng() % cardinalityB));
+    }
+    return table;
+}
+
+#endif